@@ -35,12 +35,81 @@
 #error "C99 or newer is required"
 #endif /* C99 check */
 
+/* Concurrent containers require C11 atomics. */
+#if (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#define GENC_HAS_ATOMICS 1
+#endif /* C11 atomics check */
+
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef GENC_HAS_ATOMICS
+#include <stdatomic.h>
+#endif // GENC_HAS_ATOMICS
+
+#if defined(__SSE2__) && !defined(GENC_NO_SIMD)
+#define GENC_HAS_SSE2 1
+#include <emmintrin.h>
+#endif // GENC_HAS_SSE2
+
+/* AVX2 code paths are compiled with a target attribute and selected at run
+ * time, so they do not require building with -mavx2. */
+#if defined(GENC_HAS_SSE2) && defined(__GNUC__) &&                             \
+    (defined(__x86_64__) || defined(__i386__))
+#define GENC_HAS_AVX2_DISPATCH 1
+#include <immintrin.h>
+#endif // GENC_HAS_AVX2_DISPATCH
+
+/* Vector file snapshots and the buffered writer need POSIX I/O. mmap-backed
+ * vectors also use mremap(), which glibc only declares when _GNU_SOURCE is
+ * defined before the first system header is included. Without it, they fall
+ * back to realloc(). Positional writer flushes need pwritev(), which glibc
+ * declares unless a strict standard mode is requested. */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(GENC_NO_MMAP)
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define GENC_HAS_POSIX_IO 1
+#if defined(__linux__) && defined(MREMAP_MAYMOVE) && defined(MAP_ANONYMOUS)
+#define GENC_HAS_MREMAP 1
+#endif
+#if defined(__linux__) && defined(_DEFAULT_SOURCE)
+#define GENC_HAS_PWRITEV 1
+#endif
+#endif // GENC_HAS_POSIX_IO
+
+#ifndef GENC_CACHE_LINE_SIZE
+#define GENC_CACHE_LINE_SIZE 64
+#endif // GENC_CACHE_LINE_SIZE
+
+/* Executed by blocking operations of concurrent containers between retries.
+ * Defaults to a CPU spin-wait hint. May be defined as, e.g., sched_yield(). */
+#ifndef GENC_SPIN_YIELD
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GENC_SPIN_YIELD() __builtin_ia32_pause()
+#else
+#define GENC_SPIN_YIELD() ((void)0)
+#endif
+#endif // GENC_SPIN_YIELD
+
+/* Branch prediction and code placement hints for hot paths. */
+#if defined(__GNUC__)
+#define GENC_LIKELY(x) __builtin_expect(!!(x), 1)
+#define GENC_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define GENC_COLD __attribute__((cold, noinline))
+#else
+#define GENC_LIKELY(x) (x)
+#define GENC_UNLIKELY(x) (x)
+#define GENC_COLD
+#endif // GENC_LIKELY
+
 #ifndef GENC_ERR_BASE
 #define GENC_ERR_BASE 1000
 #endif // GENC_ERR_BASE
@@ -49,1166 +118,10990 @@
 #define GENC_ERR_ALLOC_FAIL (GENC_ERR_BASE + 2)
 #define GENC_ERR_OUT_OF_BOUNDS (GENC_ERR_BASE + 3)
 #define GENC_ERR_NO_DATA (GENC_ERR_BASE + 4)
+#define GENC_ERR_FULL (GENC_ERR_BASE + 5)
+#define GENC_ERR_IO (GENC_ERR_BASE + 6)
+#define GENC_ERR_BAD_FORMAT (GENC_ERR_BASE + 7)
 #define GENC_ERR_UNEXPECTED (GENC_ERR_BASE + 100)
 
+/* Bit operations shared by the containers. `val` must be nonzero for
+ * genc_ctz32() and genc_ctz64(). With GCC and Clang, these compile to single
+ * instructions (e.g. tzcnt, popcnt) when the target enables them. */
+
+static inline unsigned
+genc_ctz32(uint32_t val)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctz(val);
+#else
+    unsigned n = 0;
+    while(!(val & 1))
+    {
+        val >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+static inline unsigned
+genc_ctz64(uint64_t val)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctzll(val);
+#else
+    unsigned n = 0;
+    while(!(val & 1))
+    {
+        val >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/* Returns the index of the highest set bit. `val` must be nonzero. */
+static inline unsigned
+genc_msb64(uint64_t val)
+{
+#if defined(__GNUC__)
+    return 63u - (unsigned)__builtin_clzll(val);
+#else
+    unsigned n = 0;
+    while(val >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+static inline unsigned
+genc_popcount32(uint32_t val)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcount(val);
+#else
+    val = val - ((val >> 1) & 0x55555555u);
+    val = (val & 0x33333333u) + ((val >> 2) & 0x33333333u);
+    val = (val + (val >> 4)) & 0x0F0F0F0Fu;
+    return (unsigned)((val * 0x01010101u) >> 24);
+#endif
+}
+
+static inline unsigned
+genc_popcount64(uint64_t val)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcountll(val);
+#else
+    val = val - ((val >> 1) & 0x5555555555555555u);
+    val = (val & 0x3333333333333333u) + ((val >> 2) & 0x3333333333333333u);
+    val = (val + (val >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+    return (unsigned)((val * 0x0101010101010101u) >> 56);
+#endif
+}
+
 /* ========================================================================== */
 /* -------------------------------------------------------------------------- */
-/* VECTOR */
+/* ALLOCATOR */
 /* -------------------------------------------------------------------------- */
 /* ========================================================================== */
 
-/* GENC_VECTOR_DECLARE() and GENC_VECTOR_DEFINE() generate a type-safe dynamic
- * vector API. GENC_VECTOR_INLINE() generates both with `static inline`.
+/* struct genc_alloc describes a user-provided allocator. Containers generated
+ * with the *_ALLOC generator macros store a pointer to one in their `alloc`
+ * member and route every allocation through it. A NULL `alloc` selects the
+ * standard heap (malloc/realloc/free), so zero-initialization stays valid.
  *
- * The generated structure must be zero-initialized before its first use.
+ * `alloc_fn` is required. `realloc_fn` may be NULL, in which case reallocation
+ * is performed as allocate-copy-free. `free_fn` may be NULL for allocators
+ * that release memory in bulk (e.g. arenas).
  *
- * GROWF controls automatic growth and shrink behavior. Values less than 1.1
- * are treated as 1.1 by operations that grow or shrink automatically. */
+ * `alloc` must not be changed while the container owns memory. */
 
 /* ========================================================================== */
-/* VECTOR - PROTOTYPES */
+/* ALLOCATOR - PROTOTYPES */
 /* ========================================================================== */
 
 /* --------------------------------------------------------|
 
-struct <name>
+struct genc_alloc
 {
-    <type>* data;
-    size_t size;
-    size_t cap;
+    void* (*alloc_fn)(void* ctx, size_t size);
+    void* (*realloc_fn)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    void (*free_fn)(void* ctx, void* ptr, size_t size);
+    void* ctx;
 };
 
 |----------------------------------------------------------|
 
-* Deinitializes the vector and frees allocated memory.
+* Allocates `size` bytes through `alloc`, or through malloc() if `alloc` is
+* NULL.
 
-* RETURN VALUE: 0 on success, error code on failure.
+* RETURN VALUE: Pointer to the allocated memory, NULL on failure.
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
+void* genc_mem_alloc(struct genc_alloc const* alloc, size_t size);
 
-int <name>_deinit(struct <name>* vec);
+|----------------------------------------------------------|
+
+* Resizes the block `ptr` of `old_size` bytes to `new_size` bytes. If `ptr`
+* is NULL, this is equivalent to genc_mem_alloc(). On failure, `ptr` is left
+* untouched.
+
+* RETURN VALUE: Pointer to the resized memory, NULL on failure.
+
+void* genc_mem_realloc(struct genc_alloc const* alloc, void* ptr,
+                       size_t old_size, size_t new_size);
 
 |----------------------------------------------------------|
 
-* Inserts `count` elements from `data` at `pos`.
-* `pos` may equal the vector size to append the elements.
+* Releases the block `ptr` of `size` bytes. `ptr` may be NULL.
 
-* RETURN VALUE: 0 on success, error code on failure.
+void genc_mem_free(struct genc_alloc const* alloc, void* ptr, size_t size);
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL, or `data` is NULL when `count` is nonzero.
-* GENC_ERR_OUT_OF_BOUNDS: `pos` is greater than the vector size.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
-* cannot be represented.
+|-------------------------------------------------------- */
 
-int <name>_ins_many(struct <name>* vec, <type> const * data,
-                    size_t count, size_t pos);
+struct genc_alloc
+{
+    void* (*alloc_fn)(void* ctx, size_t size);
+    void* (*realloc_fn)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    void (*free_fn)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+};
 
-|----------------------------------------------------------|
+static inline void*
+genc_mem_alloc(struct genc_alloc const* alloc, size_t size)
+{
+    if(!alloc) return malloc(size);
 
-* Appends `count` elements from `data` to the vector.
+    return alloc->alloc_fn(alloc->ctx, size);
+}
 
-* RETURN VALUE: 0 on success, error code on failure.
+static inline void*
+genc_mem_realloc(struct genc_alloc const* alloc, void* ptr,
+                 size_t old_size, size_t new_size)
+{
+    if(!alloc) return realloc(ptr, new_size);
+    if(!ptr) return alloc->alloc_fn(alloc->ctx, new_size);
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL, or `data` is NULL when `count` is nonzero.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
-* cannot be represented.
+    if(alloc->realloc_fn)
+        return alloc->realloc_fn(alloc->ctx, ptr, old_size, new_size);
 
-int <name>_pushb_many(struct <name>* vec, <type> const* data, size_t count);
+    void* new_ptr = alloc->alloc_fn(alloc->ctx, new_size);
+    if(!new_ptr) return NULL;
 
-|----------------------------------------------------------|
+    memcpy(new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
 
-* Removes `count` elements starting at `pos`.
+    if(alloc->free_fn)
+        alloc->free_fn(alloc->ctx, ptr, old_size);
 
-* RETURN VALUE: 0 on success, error code on failure.
+    return new_ptr;
+}
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_OUT_OF_BOUNDS: The range [`pos`, `pos + count`) is outside the
-* vector.
+static inline void
+genc_mem_free(struct genc_alloc const* alloc, void* ptr, size_t size)
+{
+    if(!ptr) return;
 
-int <name>_rm_at_many(struct <name>* vec, size_t pos, size_t count);
+    if(!alloc)
+        free(ptr);
+    else if(alloc->free_fn)
+        alloc->free_fn(alloc->ctx, ptr, size);
+}
 
-|----------------------------------------------------------|
+/* The generator macros access memory through the following adapters. The
+ * first argument is the container that performs the allocation. RELEASE_ALL
+ * adapters release all of a container's memory at once and evaluate to
+ * nonzero, or evaluate to 0 if memory has to be freed block by block. */
+
+#define GENC_MEM_STD_ALLOC(OWNER, SIZE) malloc(SIZE)
+#define GENC_MEM_STD_REALLOC(OWNER, PTR, OLD_SIZE, NEW_SIZE)                   \
+    realloc((PTR), (NEW_SIZE))
+#define GENC_MEM_STD_FREE(OWNER, PTR, SIZE) free(PTR)
+#define GENC_MEM_STD_RELEASE_ALL(OWNER) 0
+
+#define GENC_MEM_HOOK_ALLOC(OWNER, SIZE)                                       \
+    genc_mem_alloc((OWNER)->alloc, (SIZE))
+#define GENC_MEM_HOOK_REALLOC(OWNER, PTR, OLD_SIZE, NEW_SIZE)                  \
+    genc_mem_realloc((OWNER)->alloc, (PTR), (OLD_SIZE), (NEW_SIZE))
+#define GENC_MEM_HOOK_FREE(OWNER, PTR, SIZE)                                   \
+    genc_mem_free((OWNER)->alloc, (PTR), (SIZE))
+#define GENC_MEM_HOOK_RELEASE_ALL(OWNER) 0
 
-* Removes `count` elements from the back of the vector.
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* ARENA */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
 
-* RETURN VALUE: 0 on success, error code on failure.
+/* struct genc_arena is a chunked bump (region) allocator. Memory is carved
+ * sequentially from chunks of `chunk_size` bytes. Individual blocks are not
+ * freed; genc_arena_reset() releases every block at once in O(1) while
+ * keeping the chunks for reuse, and genc_arena_deinit() returns the chunks
+ * to the heap.
+ *
+ * The most recently allocated block can be grown or shrunk in place, and
+ * freeing it returns its space to the arena. This makes the common "push to
+ * the only growing vector" pattern allocation-free after warm-up.
+ *
+ * After genc_arena_init(), `arena->alloc` can be assigned to the `alloc`
+ * member of any container generated with an *_ALLOC macro. Such containers
+ * need not be deinitialized individually: resetting or deinitializing the
+ * arena releases their memory. They must not be used afterwards without
+ * being zeroed first. The arena must not be moved after initialization.
+ *
+ * Blocks are aligned to GENC_ARENA_ALIGN bytes, which must be a power of two. */
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_OUT_OF_BOUNDS: `count` is greater than the vector size.
+#ifndef GENC_ARENA_ALIGN
+#define GENC_ARENA_ALIGN 16
+#endif // GENC_ARENA_ALIGN
 
-int <name>_popb_many(struct <name>* vec, size_t count);
+#ifndef GENC_ARENA_DEFAULT_CHUNK_SIZE
+#define GENC_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+#endif // GENC_ARENA_DEFAULT_CHUNK_SIZE
+
+/* ========================================================================== */
+/* ARENA - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct genc_arena
+{
+    struct genc_arena_chunk *head, *cur;
+    void* last;
+    size_t chunk_size;
+    struct genc_alloc alloc;
+};
 
 |----------------------------------------------------------|
 
-* Shrinks allocated capacity when the vector is sufficiently sparse.
-* The shrink threshold and resulting capacity are derived from GROWF.
-* If the vector is empty, all allocated storage is freed.
-* Shrinking is best-effort: failure to reduce capacity is not an error.
+* Initializes the arena. No memory is allocated until the first allocation.
+* If `chunk_size` is 0, GENC_ARENA_DEFAULT_CHUNK_SIZE is used.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_INV_ARG: `arena` is NULL.
 
-int <name>_shrink(struct <name>* vec);
+int genc_arena_init(struct genc_arena* arena, size_t chunk_size);
 
 |----------------------------------------------------------|
 
-* Removes `count` elements starting at `pos`. Then, a call to
-* <name>_shrink() is performed.
+* Frees all chunks. Every block allocated from the arena becomes invalid.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_OUT_OF_BOUNDS: The range [`pos`, `pos + count`) is outside the
-* vector.
+* GENC_ERR_INV_ARG: `arena` is NULL.
 
-int <name>_rm_at_many_shrink(struct <name>* vec, size_t pos, size_t count);
+int genc_arena_deinit(struct genc_arena* arena);
 
 |----------------------------------------------------------|
 
-* Removes `count` elements from the back of the vector. Then,
-* a call to <name>_shrink() is performed.
+* Releases every block allocated from the arena in O(1). Chunks are kept
+* and reused by later allocations.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_OUT_OF_BOUNDS: `count` is greater than the vector size.
+* GENC_ERR_INV_ARG: `arena` is NULL.
 
-int <name>_popb_many_shrink(struct <name>* vec, size_t count);
+int genc_arena_reset(struct genc_arena* arena);
 
 |----------------------------------------------------------|
 
-* Inserts an element at `pos`.
-* `pos` may equal the vector size to append the element.
+* Allocates `size` bytes from the arena. Requests larger than the chunk size
+* are served from a dedicated chunk.
 
-* RETURN VALUE: 0 on success, error code on failure.
+* RETURN VALUE: Pointer to the allocated memory, NULL on failure.
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_OUT_OF_BOUNDS: `pos` is greater than the vector size.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
-* cannot be represented.
+void* genc_arena_alloc(struct genc_arena* arena, size_t size);
 
-int <name>_ins(struct <name>* vec, <type> data, size_t pos);
+|----------------------------------------------------------|
+
+* Resizes the block `ptr` of `old_size` bytes to `new_size` bytes. If `ptr`
+* is the most recently allocated block and the current chunk has room, the
+* block is resized in place. Shrinking any other block returns it unchanged.
+* Otherwise a new block is allocated and the contents are copied. If `ptr` is
+* NULL, this is equivalent to genc_arena_alloc().
+
+* RETURN VALUE: Pointer to the resized memory, NULL on failure.
+
+void* genc_arena_realloc(struct genc_arena* arena, void* ptr,
+                         size_t old_size, size_t new_size);
 
 |----------------------------------------------------------|
 
-* Appends an element to the vector.
+* Releases the block `ptr`. Only the most recently allocated block is
+* actually reclaimed; for any other block this is a no-op.
 
-* RETURN VALUE: 0 on success, error code on failure.
+void genc_arena_free(struct genc_arena* arena, void* ptr);
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
-* cannot be represented.
+|-------------------------------------------------------- */
 
-int <name>_pushb(struct <name>* vec, <type> data);
+struct genc_arena_chunk
+{
+    struct genc_arena_chunk* next;
+    size_t cap;
+    size_t used;
+};
 
-|----------------------------------------------------------|
+struct genc_arena
+{
+    struct genc_arena_chunk *head, *cur;
+    void* last;
+    size_t chunk_size;
+    struct genc_alloc alloc;
+};
 
-* Removes the element at `pos`.
+static inline char*
+genc_arena_chunk_base(struct genc_arena_chunk* chunk)
+{
+    return (char*)(chunk + 1);
+}
 
-* RETURN VALUE: 0 on success, error code on failure.
+/* Returns the offset at which a block of `size` bytes would start in `chunk`,
+ * or SIZE_MAX if it does not fit. */
+static inline size_t
+genc_arena_chunk_fit(struct genc_arena_chunk* chunk, size_t size)
+{
+    uintptr_t addr = (uintptr_t)(genc_arena_chunk_base(chunk) + chunk->used);
+    size_t pad = (size_t)((GENC_ARENA_ALIGN -
+                           (addr & (GENC_ARENA_ALIGN - 1))) &
+                          (GENC_ARENA_ALIGN - 1));
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_OUT_OF_BOUNDS: `pos` is outside the vector.
+    if(pad > chunk->cap - chunk->used) return SIZE_MAX;
+    if(size > chunk->cap - chunk->used - pad) return SIZE_MAX;
 
-int <name>_rm_at(struct <name>* vec, size_t pos);
+    return chunk->used + pad;
+}
 
-|----------------------------------------------------------|
+static inline void*
+genc_arena_alloc(struct genc_arena* arena, size_t size)
+{
+    if(!arena) return NULL;
+
+    if(size == 0) size = 1;
+
+    struct genc_arena_chunk* chunk = arena->cur;
+    size_t offset = chunk ? genc_arena_chunk_fit(chunk, size) : SIZE_MAX;
+
+    /* Move on to chunks retained by a previous reset. Chunks too small for
+     * this request are skipped until the next reset. */
+    while((offset == SIZE_MAX) && chunk && chunk->next)
+    {
+        chunk = chunk->next;
+        chunk->used = 0;
+        offset = genc_arena_chunk_fit(chunk, size);
+    }
+
+    if(offset == SIZE_MAX)
+    {
+        size_t cap = arena->chunk_size;
+        if(size > SIZE_MAX - GENC_ARENA_ALIGN) return NULL;
+        if(cap < size + GENC_ARENA_ALIGN) cap = size + GENC_ARENA_ALIGN;
+        if(cap > SIZE_MAX - sizeof(struct genc_arena_chunk)) return NULL;
+
+        struct genc_arena_chunk* new_chunk =
+            malloc(sizeof(struct genc_arena_chunk) + cap);
+        if(!new_chunk) return NULL;
+
+        new_chunk->cap = cap;
+        new_chunk->used = 0;
+
+        if(!chunk)
+        {
+            new_chunk->next = NULL;
+            arena->head = new_chunk;
+        }
+        else
+        {
+            new_chunk->next = chunk->next;
+            chunk->next = new_chunk;
+        }
+
+        chunk = new_chunk;
+        offset = genc_arena_chunk_fit(chunk, size);
+    }
+
+    arena->cur = chunk;
+    chunk->used = offset + size;
+    arena->last = genc_arena_chunk_base(chunk) + offset;
+
+    return arena->last;
+}
 
-* Removes the last element from the vector.
+static inline void*
+genc_arena_realloc(struct genc_arena* arena, void* ptr,
+                   size_t old_size, size_t new_size)
+{
+    if(!arena) return NULL;
+    if(!ptr) return genc_arena_alloc(arena, new_size);
 
-* RETURN VALUE: 0 on success, error code on failure.
+    if(new_size == 0) new_size = 1;
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_NO_DATA: The vector is empty.
+    if((ptr == arena->last) && arena->cur)
+    {
+        struct genc_arena_chunk* chunk = arena->cur;
+        size_t offset = (size_t)((char*)ptr - genc_arena_chunk_base(chunk));
 
-int <name>_popb(struct <name>* vec);
+        if(new_size <= chunk->cap - offset)
+        {
+            chunk->used = offset + new_size;
+            return ptr;
+        }
+    }
 
-|----------------------------------------------------------|
+    /* Shrinking a block that is not the most recent one cannot reclaim
+     * anything, so the block is kept as is. */
+    if(new_size <= old_size) return ptr;
 
-* Removes the element at `pos` and may shrink allocated capacity.
-* Shrinking is best-effort. If the vector becomes empty, its storage is freed.
+    void* new_ptr = genc_arena_alloc(arena, new_size);
+    if(!new_ptr) return NULL;
 
-* RETURN VALUE: 0 on success, error code on failure.
+    memcpy(new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_OUT_OF_BOUNDS: `pos` is outside the vector.
+    return new_ptr;
+}
 
-int <name>_rm_at_shrink(struct <name>* vec, size_t pos);
+static inline void
+genc_arena_free(struct genc_arena* arena, void* ptr)
+{
+    if(!arena || !ptr) return;
+
+    if((ptr == arena->last) && arena->cur)
+    {
+        arena->cur->used = (size_t)((char*)ptr -
+                                    genc_arena_chunk_base(arena->cur));
+        arena->last = NULL;
+    }
+}
 
-|----------------------------------------------------------|
+static inline void*
+genc_arena_alloc_fn(void* ctx, size_t size)
+{
+    return genc_arena_alloc((struct genc_arena*)ctx, size);
+}
 
-* Removes the last element and may shrink allocated capacity.
-* Shrinking is best-effort. If the vector becomes empty, its storage is freed.
+static inline void*
+genc_arena_realloc_fn(void* ctx, void* ptr, size_t old_size, size_t new_size)
+{
+    return genc_arena_realloc((struct genc_arena*)ctx, ptr,
+                              old_size, new_size);
+}
 
-* RETURN VALUE: 0 on success, error code on failure.
+static inline void
+genc_arena_free_fn(void* ctx, void* ptr, size_t size)
+{
+    (void)size;
+    genc_arena_free((struct genc_arena*)ctx, ptr);
+}
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_NO_DATA: The vector is empty.
+static inline int
+genc_arena_init(struct genc_arena* arena, size_t chunk_size)
+{
+    if(!arena) return GENC_ERR_INV_ARG;
 
-int <name>_popb_shrink(struct <name>* vec);
+    arena->head = NULL;
+    arena->cur = NULL;
+    arena->last = NULL;
+    arena->chunk_size = (chunk_size > 0) ?
+        chunk_size : GENC_ARENA_DEFAULT_CHUNK_SIZE;
 
-|----------------------------------------------------------|
+    arena->alloc.alloc_fn = genc_arena_alloc_fn;
+    arena->alloc.realloc_fn = genc_arena_realloc_fn;
+    arena->alloc.free_fn = genc_arena_free_fn;
+    arena->alloc.ctx = arena;
 
-* Removes all elements while retaining allocated capacity.
+    return 0;
+}
 
-* RETURN VALUE: 0 on success, error code on failure.
+static inline int
+genc_arena_deinit(struct genc_arena* arena)
+{
+    if(!arena) return GENC_ERR_INV_ARG;
+
+    struct genc_arena_chunk* it = arena->head;
+    struct genc_arena_chunk* next;
+    while(it)
+    {
+        next = it->next;
+        free(it);
+        it = next;
+    }
+
+    arena->head = NULL;
+    arena->cur = NULL;
+    arena->last = NULL;
+
+    return 0;
+}
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
+static inline int
+genc_arena_reset(struct genc_arena* arena)
+{
+    if(!arena) return GENC_ERR_INV_ARG;
 
-int <name>_empty(struct <name>* vec);
+    arena->cur = arena->head;
+    arena->last = NULL;
+
+    if(arena->cur)
+        arena->cur->used = 0;
+
+    return 0;
+}
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* POOL */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* struct genc_pool is a fixed-size object pool. Objects are carved from slabs
+ * of `slab_size` objects and freed objects are recycled through an internal
+ * free list, so steady-state allocation and deallocation never reach the
+ * heap. The object size is fixed by the first allocation.
+ *
+ * The structure must be zero-initialized before its first use. `slab_size`
+ * may be set before the first allocation; 0 selects
+ * GENC_POOL_DEFAULT_SLAB_SIZE.
+ *
+ * The first object of every slab is aligned to GENC_POOL_ALIGN bytes, which
+ * must be a power of two no smaller than the alignment of the objects. */
+
+#ifndef GENC_POOL_ALIGN
+#define GENC_POOL_ALIGN 16
+#endif // GENC_POOL_ALIGN
+
+#ifndef GENC_POOL_DEFAULT_SLAB_SIZE
+#define GENC_POOL_DEFAULT_SLAB_SIZE 256
+#endif // GENC_POOL_DEFAULT_SLAB_SIZE
+
+/* ========================================================================== */
+/* POOL - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct genc_pool
+{
+    struct genc_pool_slab* slabs;
+    void* free_list;
+    char* bump;
+    size_t bump_left;
+    size_t obj_size;
+    size_t slab_size;
+    size_t used;
+};
 
 |----------------------------------------------------------|
 
-* Removes all elements and frees allocated capacity.
+* Frees all slabs. Every object allocated from the pool becomes invalid.
+* `slab_size` is retained, so the pool may be reused.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_INV_ARG: `pool` is NULL.
 
-int <name>_empty_shrink(struct <name>* vec);
+int genc_pool_deinit(struct genc_pool* pool);
 
 |----------------------------------------------------------|
 
-* Shrinks allocated capacity to the current vector size.
+* Allocates an object of `size` bytes. `size` must be the same for every
+* allocation made from the pool.
 
-* RETURN VALUE: 0 on success, error code on failure.
+* RETURN VALUE: Pointer to the allocated object, NULL on failure.
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+void* genc_pool_alloc(struct genc_pool* pool, size_t size);
 
-int <name>_fit(struct <name>* vec);
+|----------------------------------------------------------|
+
+* Returns the object `ptr` to the pool. `ptr` may be NULL.
+
+void genc_pool_free(struct genc_pool* pool, void* ptr);
 
 |----------------------------------------------------------|
 
-* Increases vector capacity by `size` elements.
+* Frees slabs that hold no live objects.
+* Trimming is best-effort: failure to release slabs is not an error.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `vec` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
-* cannot be represented.
+* GENC_ERR_INV_ARG: `pool` is NULL.
 
-int <name>_prealloc(struct <name>* vec, size_t size);
+int genc_pool_trim(struct genc_pool* pool);
 
 |-------------------------------------------------------- */
 
-/* ========================================================================== */
-/* VECTOR - GENERATOR MACROS */
-/* ========================================================================== */
+struct genc_pool_slab
+{
+    struct genc_pool_slab* next;
+    size_t cap;
+};
 
-/* -------------------------------------------------------------------------- */
-/* VECTOR - DECLARE */
-/* -------------------------------------------------------------------------- */
+struct genc_pool
+{
+    struct genc_pool_slab* slabs;
+    void* free_list;
+    char* bump;
+    size_t bump_left;
+    size_t obj_size;
+    size_t slab_size;
+    size_t used;
+};
 
-#define GENC_VECTOR_DECLARE(NAME, TYPE, FN_PREFIX)                             \
-struct NAME                                                                    \
-{                                                                              \
-    TYPE * data;                                                               \
-    size_t size;                                                               \
-    size_t cap;                                                                \
-};                                                                             \
-                                                                               \
-FN_PREFIX int                                                                  \
-NAME##_deinit(struct NAME * v);                                                \
-                                                                               \
-FN_PREFIX int                                                                  \
-NAME##_ins_many(struct NAME * v, TYPE const * data, size_t count, size_t pos); \
+static inline char*
+genc_pool_slab_objs(struct genc_pool_slab* slab)
+{
+    uintptr_t addr = (uintptr_t)(slab + 1);
+
+    addr = (addr + (GENC_POOL_ALIGN - 1)) & ~(uintptr_t)(GENC_POOL_ALIGN - 1);
+
+    return (char*)addr;
+}
+
+static inline int
+genc_pool_deinit(struct genc_pool* pool)
+{
+    if(!pool) return GENC_ERR_INV_ARG;
+
+    struct genc_pool_slab* it = pool->slabs;
+    struct genc_pool_slab* next;
+    while(it)
+    {
+        next = it->next;
+        free(it);
+        it = next;
+    }
+
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->bump = NULL;
+    pool->bump_left = 0;
+    pool->obj_size = 0;
+    pool->used = 0;
+
+    return 0;
+}
+
+static inline void*
+genc_pool_alloc(struct genc_pool* pool, size_t size)
+{
+    if(!pool) return NULL;
+
+    if(pool->free_list)
+    {
+        void* obj = pool->free_list;
+        memcpy(&pool->free_list, obj, sizeof(void*));
+        ++(pool->used);
+        return obj;
+    }
+
+    if(pool->bump_left == 0)
+    {
+        if(pool->obj_size == 0)
+        {
+            if(size < sizeof(void*)) size = sizeof(void*);
+            if(size % sizeof(void*) != 0)
+            {
+                if(size > SIZE_MAX - sizeof(void*)) return NULL;
+                size += sizeof(void*) - (size % sizeof(void*));
+            }
+            pool->obj_size = size;
+        }
+
+        size_t cap = (pool->slab_size > 0) ?
+            pool->slab_size : GENC_POOL_DEFAULT_SLAB_SIZE;
+        size_t hdr = sizeof(struct genc_pool_slab) + GENC_POOL_ALIGN;
+
+        if(cap > (SIZE_MAX - hdr) / pool->obj_size) return NULL;
+
+        struct genc_pool_slab* slab = malloc(hdr + cap * pool->obj_size);
+        if(!slab) return NULL;
+
+        slab->cap = cap;
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+
+        pool->bump = genc_pool_slab_objs(slab);
+        pool->bump_left = cap;
+    }
+
+    void* obj = pool->bump;
+    pool->bump += pool->obj_size;
+    --(pool->bump_left);
+    ++(pool->used);
+
+    return obj;
+}
+
+static inline void
+genc_pool_free(struct genc_pool* pool, void* ptr)
+{
+    if(!pool || !ptr) return;
+
+    memcpy(ptr, &pool->free_list, sizeof(void*));
+    pool->free_list = ptr;
+    --(pool->used);
+}
+
+static inline int
+genc_pool_slab_cmp(void const* a, void const* b)
+{
+    uintptr_t x = (uintptr_t)*(struct genc_pool_slab* const*)a;
+    uintptr_t y = (uintptr_t)*(struct genc_pool_slab* const*)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Returns the index of the slab in the address-sorted `slabs` that contains
+ * `obj`. */
+static inline size_t
+genc_pool_slab_find(struct genc_pool_slab** slabs, size_t count, void* obj)
+{
+    size_t lo = 0, hi = count;
+    while(hi - lo > 1)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if((uintptr_t)slabs[mid] <= (uintptr_t)obj)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+static inline int
+genc_pool_trim(struct genc_pool* pool)
+{
+    if(!pool) return GENC_ERR_INV_ARG;
+
+    if(pool->used == 0)
+        return genc_pool_deinit(pool);
+
+    size_t count = 0;
+    struct genc_pool_slab* it;
+    for(it = pool->slabs; it; it = it->next)
+        ++count;
+
+    if(count > SIZE_MAX / (sizeof(struct genc_pool_slab*) + sizeof(size_t)))
+        return 0;
+
+    struct genc_pool_slab** slabs = malloc(count *
+        (sizeof(struct genc_pool_slab*) + sizeof(size_t)));
+    if(!slabs) return 0;
+
+    size_t* free_counts = (size_t*)(slabs + count);
+    size_t i = 0;
+    for(it = pool->slabs; it; it = it->next)
+        slabs[i++] = it;
+
+    qsort(slabs, count, sizeof(struct genc_pool_slab*), genc_pool_slab_cmp);
+    memset(free_counts, 0, count * sizeof(size_t));
+
+    void* obj;
+    void* next;
+    for(obj = pool->free_list; obj; obj = next)
+    {
+        memcpy(&next, obj, sizeof(void*));
+        ++free_counts[genc_pool_slab_find(slabs, count, obj)];
+    }
+
+    /* The slab being carved is always the head of `pool->slabs`. */
+    if(pool->slabs)
+    {
+        size_t idx = genc_pool_slab_find(slabs, count,
+                                         genc_pool_slab_objs(pool->slabs));
+        free_counts[idx] += pool->bump_left;
+    }
+
+    void* prev = NULL;
+    for(obj = pool->free_list; obj; obj = next)
+    {
+        memcpy(&next, obj, sizeof(void*));
+
+        size_t idx = genc_pool_slab_find(slabs, count, obj);
+        if(free_counts[idx] == slabs[idx]->cap)
+            continue;
+
+        if(prev)
+            memcpy(prev, &obj, sizeof(void*));
+        else
+            pool->free_list = obj;
+        prev = obj;
+    }
+
+    if(prev)
+        memcpy(prev, &next, sizeof(void*));
+    else
+        pool->free_list = NULL;
+
+    struct genc_pool_slab** slab_link = &pool->slabs;
+    struct genc_pool_slab* slab_next;
+    for(it = pool->slabs; it; it = slab_next)
+    {
+        slab_next = it->next;
+        size_t idx = genc_pool_slab_find(slabs, count,
+                                         genc_pool_slab_objs(it));
+        if(free_counts[idx] == it->cap)
+        {
+            if(it == pool->slabs)
+            {
+                pool->bump = NULL;
+                pool->bump_left = 0;
+            }
+            free(it);
+            continue;
+        }
+
+        *slab_link = it;
+        slab_link = &it->next;
+    }
+    *slab_link = NULL;
+
+    free(slabs);
+
+    return 0;
+}
+
+/* Adapters for generator macros. The container stores its pool in the `pool`
+ * member. */
+
+#define GENC_MEM_POOL_ALLOC(OWNER, SIZE)                                       \
+    genc_pool_alloc(&(OWNER)->pool, (SIZE))
+#define GENC_MEM_POOL_FREE(OWNER, PTR, SIZE)                                   \
+    genc_pool_free(&(OWNER)->pool, (PTR))
+#define GENC_MEM_POOL_RELEASE_ALL(OWNER)                                       \
+    (genc_pool_deinit(&(OWNER)->pool), 1)
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* VECTOR */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_VECTOR_DECLARE() and GENC_VECTOR_DEFINE() generate a type-safe dynamic
+ * vector API. GENC_VECTOR_INLINE() generates both with `static inline`.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ *
+ * GROWF controls automatic growth and shrink behavior. Values less than 1.1
+ * are treated as 1.1 by operations that grow or shrink automatically.
+ *
+ * GENC_VECTOR_DECLARE_ALLOC(), GENC_VECTOR_DEFINE_ALLOC() and
+ * GENC_VECTOR_INLINE_ALLOC() generate the same API, but the structure gains an
+ * `alloc` member through which all memory is managed (see ALLOCATOR).
+ *
+ * GENC_VECTOR_DEFINE_MMAP() and GENC_VECTOR_INLINE_MMAP() generate the same
+ * API for very large vectors. Buffers of at least GENC_VECTOR_MMAP_THRESHOLD
+ * bytes are anonymous mappings that grow and shrink with mremap(), so the
+ * kernel moves page table entries instead of copying the elements, and
+ * shrinking returns the released pages to the system. Defining
+ * GENC_VECTOR_MMAP_HUGEPAGE requests transparent huge pages for the mappings.
+ * Smaller buffers and non-Linux targets use realloc(). The structure is the
+ * one generated by GENC_VECTOR_DECLARE(). */
+
+/* ========================================================================== */
+/* VECTOR - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    <type>* data;
+    size_t size;
+    size_t cap;
+};
+
+|----------------------------------------------------------|
+
+struct <name> (generated by the *_ALLOC variants)
+{
+    <type>* data;
+    size_t size;
+    size_t cap;
+    struct genc_alloc const* alloc;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the vector and frees allocated memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_deinit(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Inserts `count` elements from `data` at `pos`.
+* `pos` may equal the vector size to append the elements.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL, or `data` is NULL when `count` is nonzero.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is greater than the vector size.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_ins_many(struct <name>* vec, <type> const * data,
+                    size_t count, size_t pos);
+
+|----------------------------------------------------------|
+
+* Appends `count` elements from `data` to the vector.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL, or `data` is NULL when `count` is nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_pushb_many(struct <name>* vec, <type> const* data, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes `count` elements starting at `pos`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: The range [`pos`, `pos + count`) is outside the
+* vector.
+
+int <name>_rm_at_many(struct <name>* vec, size_t pos, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes `count` elements from the back of the vector.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `count` is greater than the vector size.
+
+int <name>_popb_many(struct <name>* vec, size_t count);
+
+|----------------------------------------------------------|
+
+* Shrinks allocated capacity when the vector is sufficiently sparse.
+* The shrink threshold and resulting capacity are derived from GROWF.
+* If the vector is empty, all allocated storage is freed.
+* Shrinking is best-effort: failure to reduce capacity is not an error.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_shrink(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Removes `count` elements starting at `pos`. Then, a call to
+* <name>_shrink() is performed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: The range [`pos`, `pos + count`) is outside the
+* vector.
+
+int <name>_rm_at_many_shrink(struct <name>* vec, size_t pos, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes `count` elements from the back of the vector. Then,
+* a call to <name>_shrink() is performed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `count` is greater than the vector size.
+
+int <name>_popb_many_shrink(struct <name>* vec, size_t count);
+
+|----------------------------------------------------------|
+
+* Inserts an element at `pos`.
+* `pos` may equal the vector size to append the element.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is greater than the vector size.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_ins(struct <name>* vec, <type> data, size_t pos);
+
+|----------------------------------------------------------|
+
+* Appends an element to the vector.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_pushb(struct <name>* vec, <type> data);
+
+|----------------------------------------------------------|
+
+* Removes the element at `pos`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is outside the vector.
+
+int <name>_rm_at(struct <name>* vec, size_t pos);
+
+|----------------------------------------------------------|
+
+* Removes the last element from the vector.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_NO_DATA: The vector is empty.
+
+int <name>_popb(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Unchecked variants of <name>_ins(), <name>_pushb(), <name>_rm_at() and
+* <name>_popb() for hot loops. Arguments are not validated: `vec` must not be
+* NULL, `pos` must be within the bounds of the respective checked function,
+* and the vector must not be empty when removing. Growth is outlined, so the
+* common path only compares the size against the capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented (insertion only).
+
+int <name>_ins_unchecked(struct <name>* vec, <type> data, size_t pos);
+int <name>_pushb_unchecked(struct <name>* vec, <type> data);
+int <name>_rm_at_unchecked(struct <name>* vec, size_t pos);
+int <name>_popb_unchecked(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Appends an uninitialized element and returns a pointer to it, so that
+* large elements can be constructed in place.
+
+* RETURN VALUE: Pointer to the new element, NULL if `vec` is NULL or memory
+* allocation failed.
+
+<type>* <name>_emplace_back(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* <name>_reserve_back() ensures room for `count` more elements and returns a
+* pointer to the uninitialized space after the last element. The space may be
+* written directly, e.g. by read(), and the written elements are appended with
+* <name>_commit_back(). The pointer is invalidated by any operation that
+* reallocates the vector.
+
+* RETURN VALUE: <name>_reserve_back(): Pointer to the reserved space, NULL if
+* `vec` is NULL, `count` is 0 or memory allocation failed.
+* <name>_commit_back(): 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `count` exceeds the spare capacity.
+
+<type>* <name>_reserve_back(struct <name>* vec, size_t count);
+int <name>_commit_back(struct <name>* vec, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes every element for which `pred` returns true, in a single pass. The
+* order of the remaining elements is preserved. `ctx` is passed to `pred`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` or `pred` is NULL.
+
+int <name>_remove_if(struct <name>* vec,
+                     bool (*pred)(<type> const* elem, void* ctx), void* ctx);
+
+|----------------------------------------------------------|
+
+* Removes the element at `pos` in O(1) by moving the last element into its
+* place. The order of the elements is not preserved.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is outside the vector.
+
+int <name>_swap_rm_at(struct <name>* vec, size_t pos);
+
+|----------------------------------------------------------|
+
+* Removes consecutive elements that `eq` considers equal, keeping the first of
+* each run. On a sorted vector, this leaves unique elements.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` or `eq` is NULL.
+
+int <name>_dedup_sorted(struct <name>* vec,
+                        bool (*eq)(<type> const* a, <type> const* b));
+
+|----------------------------------------------------------|
+
+* Same as <name>_remove_if(), <name>_swap_rm_at() and <name>_dedup_sorted().
+* Then, a call to <name>_shrink() is performed.
+
+int <name>_remove_if_shrink(struct <name>* vec,
+                            bool (*pred)(<type> const* elem, void* ctx),
+                            void* ctx);
+int <name>_swap_rm_at_shrink(struct <name>* vec, size_t pos);
+int <name>_dedup_sorted_shrink(struct <name>* vec,
+                               bool (*eq)(<type> const* a, <type> const* b));
+
+|----------------------------------------------------------|
+
+* Removes the element at `pos` and may shrink allocated capacity.
+* Shrinking is best-effort. If the vector becomes empty, its storage is freed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is outside the vector.
+
+int <name>_rm_at_shrink(struct <name>* vec, size_t pos);
+
+|----------------------------------------------------------|
+
+* Removes the last element and may shrink allocated capacity.
+* Shrinking is best-effort. If the vector becomes empty, its storage is freed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_NO_DATA: The vector is empty.
+
+int <name>_popb_shrink(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Removes all elements while retaining allocated capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_empty(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Removes all elements and frees allocated capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_empty_shrink(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Shrinks allocated capacity to the current vector size.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_fit(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Increases vector capacity by `size` elements.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_prealloc(struct <name>* vec, size_t size);
+
+|-------------------------------------------------------- */
+
+#ifndef GENC_VECTOR_MMAP_THRESHOLD
+#define GENC_VECTOR_MMAP_THRESHOLD ((size_t)64 << 20)
+#endif // GENC_VECTOR_MMAP_THRESHOLD
+
+#ifdef GENC_HAS_MREMAP
+
+static inline void
+genc_vec_map_advise(void* ptr, size_t size)
+{
+#if defined(GENC_VECTOR_MMAP_HUGEPAGE) && defined(MADV_HUGEPAGE)
+    (void)madvise(ptr, size, MADV_HUGEPAGE);
+#else
+    (void)ptr;
+    (void)size;
+#endif
+}
+
+/* Reallocation for mmap-backed vectors. Whether a block is mapped follows
+ * from its size, so no extra state is stored. */
+static inline void*
+genc_vec_mmap_realloc(void* ptr, size_t old_size, size_t new_size)
+{
+    bool old_mapped = ptr && (old_size >= GENC_VECTOR_MMAP_THRESHOLD);
+    bool new_mapped = (new_size >= GENC_VECTOR_MMAP_THRESHOLD);
+
+    if(!old_mapped && !new_mapped) return realloc(ptr, new_size);
+
+    void* new_ptr;
+    if(old_mapped && new_mapped)
+    {
+        new_ptr = mremap(ptr, old_size, new_size, MREMAP_MAYMOVE);
+        if(new_ptr == MAP_FAILED) return NULL;
+
+        if(new_size > old_size) genc_vec_map_advise(new_ptr, new_size);
+
+        return new_ptr;
+    }
+
+    if(new_mapped)
+    {
+        new_ptr = mmap(NULL, new_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(new_ptr == MAP_FAILED) return NULL;
+
+        genc_vec_map_advise(new_ptr, new_size);
+    }
+    else
+    {
+        new_ptr = malloc(new_size);
+        if(!new_ptr) return NULL;
+    }
+
+    if(ptr)
+    {
+        memcpy(new_ptr, ptr, (old_size < new_size) ? old_size : new_size);
+
+        if(old_mapped)
+            munmap(ptr, old_size);
+        else
+            free(ptr);
+    }
+
+    return new_ptr;
+}
+
+static inline void
+genc_vec_mmap_free(void* ptr, size_t size)
+{
+    if(ptr && (size >= GENC_VECTOR_MMAP_THRESHOLD))
+        munmap(ptr, size);
+    else
+        free(ptr);
+}
+
+#define GENC_MEM_MMAP_REALLOC(OWNER, PTR, OLD_SIZE, NEW_SIZE)                  \
+    genc_vec_mmap_realloc((PTR), (OLD_SIZE), (NEW_SIZE))
+#define GENC_MEM_MMAP_FREE(OWNER, PTR, SIZE)                                   \
+    genc_vec_mmap_free((PTR), (SIZE))
+
+#else
+
+#define GENC_MEM_MMAP_REALLOC GENC_MEM_STD_REALLOC
+#define GENC_MEM_MMAP_FREE GENC_MEM_STD_FREE
+
+#endif // GENC_HAS_MREMAP
+
+/* ========================================================================== */
+/* VECTOR - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_VECTOR_DECLARE(NAME, TYPE, FN_PREFIX)                             \
+struct NAME                                                                    \
+{                                                                              \
+    TYPE * data;                                                               \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+};                                                                             \
+                                                                               \
+GENC_VECTOR_DECLARE_FNS(NAME, TYPE, FN_PREFIX)
+
+#define GENC_VECTOR_DECLARE_ALLOC(NAME, TYPE, FN_PREFIX)                       \
+struct NAME                                                                    \
+{                                                                              \
+    TYPE * data;                                                               \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+    struct genc_alloc const* alloc;                                            \
+};                                                                             \
+                                                                               \
+GENC_VECTOR_DECLARE_FNS(NAME, TYPE, FN_PREFIX)
+
+#define GENC_VECTOR_DECLARE_FNS(NAME, TYPE, FN_PREFIX)                         \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * v);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_many(struct NAME * v, TYPE const * data, size_t count, size_t pos); \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_many(struct NAME * v, TYPE const * data, size_t count);           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_many(struct NAME * v, size_t pos, size_t count);                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many(struct NAME * v, size_t count);                               \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_shrink(struct NAME * v);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_many_shrink(struct NAME * v, size_t pos, size_t count);           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many_shrink(struct NAME * v, size_t count);                        \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins(struct NAME * v, TYPE data, size_t pos);                            \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * v, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at(struct NAME * v, size_t pos);                                     \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * v);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_unchecked(struct NAME * v, TYPE data, size_t pos);                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_unchecked(struct NAME * v, TYPE data);                            \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_unchecked(struct NAME * v, size_t pos);                           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_unchecked(struct NAME * v);                                        \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_emplace_back(struct NAME * v);                                          \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_reserve_back(struct NAME * v, size_t count);                            \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_commit_back(struct NAME * v, size_t count);                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_remove_if(struct NAME * v, bool (*pred)(TYPE const * elem, void* ctx),  \
+                 void* ctx);                                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_swap_rm_at(struct NAME * v, size_t pos);                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_dedup_sorted(struct NAME * v,                                           \
+                    bool (*eq)(TYPE const * a, TYPE const * b));               \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_remove_if_shrink(struct NAME * v,                                       \
+                        bool (*pred)(TYPE const * elem, void* ctx),            \
+                        void* ctx);                                            \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_swap_rm_at_shrink(struct NAME * v, size_t pos);                         \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_dedup_sorted_shrink(struct NAME * v,                                    \
+                           bool (*eq)(TYPE const * a, TYPE const * b));        \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_shrink(struct NAME * v, size_t pos);                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_shrink(struct NAME * v);                                           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * v);                                                 \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty_shrink(struct NAME * v);                                          \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * v);                                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * v, size_t size);
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_VECTOR_DEFINE(NAME, TYPE, GROWF, FN_PREFIX)                       \
+    GENC_VECTOR_DEFINE_IMPL(NAME, TYPE, GROWF, FN_PREFIX, 0,                   \
+                            GENC_MEM_STD_REALLOC, GENC_MEM_STD_FREE)
+
+#define GENC_VECTOR_DEFINE_ALLOC(NAME, TYPE, GROWF, FN_PREFIX)                 \
+    GENC_VECTOR_DEFINE_IMPL(NAME, TYPE, GROWF, FN_PREFIX, 0,                   \
+                            GENC_MEM_HOOK_REALLOC, GENC_MEM_HOOK_FREE)
+
+#define GENC_VECTOR_DEFINE_MMAP(NAME, TYPE, GROWF, FN_PREFIX)                  \
+    GENC_VECTOR_DEFINE_IMPL(NAME, TYPE, GROWF, FN_PREFIX, 0,                   \
+                            GENC_MEM_MMAP_REALLOC, GENC_MEM_MMAP_FREE)
+
+/* MIN_CAP is the smallest capacity worth allocating. Small vectors pass N so
+ * that the capacity jumps straight to the size of the inline buffer. */
+#define GENC_VECTOR_DEFINE_IMPL(NAME, TYPE, GROWF, FN_PREFIX, MIN_CAP,         \
+                                REALLOC, FREE)                                 \
+/* Grows the capacity to at least `req_cap` elements. Kept out of line so      \
+ * that the insertion fast paths stay small. */                                \
+static GENC_COLD int                                                           \
+NAME##__grow(struct NAME * v, size_t req_cap)                                  \
+{                                                                              \
+    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+                                                                               \
+    size_t new_cap = (size_t)((double)v->cap * growf_adj);                     \
+                                                                               \
+    if(new_cap < req_cap)                                                      \
+        new_cap = req_cap;                                                     \
+    if(new_cap <= (MIN_CAP))                                                   \
+        new_cap = (MIN_CAP);                                                   \
+                                                                               \
+    if(new_cap > SIZE_MAX / sizeof(TYPE))                                      \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    void* new_data = REALLOC(v, v->data, v->cap * sizeof(TYPE),                \
+                             new_cap * sizeof(TYPE));                          \
+    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+                                                                               \
+    v->data = new_data;                                                        \
+    v->cap = new_cap;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * v)                                                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    FREE(v, v->data, v->cap * sizeof(TYPE));                                   \
+    v->data = NULL;                                                            \
+    v->size = 0;                                                               \
+    v->cap = 0;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_many(struct NAME * v, TYPE const * data, size_t count, size_t pos)  \
+{                                                                              \
+    if(!v || (!data && count > 0))                                             \
+        return GENC_ERR_INV_ARG;                                               \
+    if(pos > v->size)                                                          \
+        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    if(count > SIZE_MAX - v->size)                                             \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    size_t req_cap = v->size + count;                                          \
+                                                                               \
+    if(req_cap > v->cap)                                                       \
+    {                                                                          \
+        int status = NAME##__grow(v, req_cap);                                 \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    char* v_data = (char*)v->data;                                             \
+                                                                               \
+    if(pos != v->size)                                                         \
+    {                                                                          \
+        memmove(v_data + ((pos + count) * sizeof(TYPE)),                       \
+                v_data + (pos * sizeof(TYPE)),                                 \
+                (v->size - pos) * sizeof(TYPE));                               \
+    }                                                                          \
+                                                                               \
+    memmove(v_data + (pos * sizeof(TYPE)), data, count * sizeof(TYPE));        \
+                                                                               \
+    v->size += count;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_many(struct NAME * v, TYPE const * data, size_t count)            \
+{                                                                              \
+    if(!v || (!data && count > 0))                                             \
+        return GENC_ERR_INV_ARG;                                               \
+                                                                               \
+    int status = NAME##_ins_many(v, data, count, v->size);                     \
+    switch(status)                                                             \
+    {                                                                          \
+        case 0:                                                                \
+            return 0;                                                          \
+        case GENC_ERR_ALLOC_FAIL:                                              \
+            return GENC_ERR_ALLOC_FAIL;                                        \
+        default:                                                               \
+            return GENC_ERR_UNEXPECTED;                                        \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_many(struct NAME * v, size_t pos, size_t count)                   \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if((pos > v->size) || (count > v->size - pos))                             \
+        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    char* v_data = (char*)v->data;                                             \
+                                                                               \
+    memmove(v_data + (pos * sizeof(TYPE)),                                     \
+            v_data + ((pos + count) * sizeof(TYPE)),                           \
+            (v->size - pos - count) * sizeof(TYPE));                           \
+                                                                               \
+    v->size -= count;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_shrink(struct NAME * v)                                                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(v->size == 0)                                                           \
+    {                                                                          \
+        FREE(v, v->data, v->cap * sizeof(TYPE));                               \
+        v->data = NULL;                                                        \
+        v->cap = 0;                                                            \
+                                                                               \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+    size_t threshold = (size_t)((double)v->cap / growf_adj / growf_adj);       \
+                                                                               \
+    if(v->size < threshold)                                                    \
+    {                                                                          \
+        size_t new_cap = (size_t)((double)v->size * growf_adj);                \
+        if(new_cap < v->size) new_cap = v->size;                               \
+        if(new_cap <= (MIN_CAP)) new_cap = (MIN_CAP);                          \
+        if(new_cap == v->cap) return 0;                                        \
+                                                                               \
+        void* new_data = REALLOC(v, v->data, v->cap * sizeof(TYPE),            \
+                                 new_cap * sizeof(TYPE));                      \
+        if(!new_data) return 0;                                                \
+                                                                               \
+        v->data = new_data;                                                    \
+        v->cap = new_cap;                                                      \
+    }                                                                          \
+    return 0;                                                                  \
+                                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many(struct NAME * v, size_t count)                                \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(count > v->size) return GENC_ERR_OUT_OF_BOUNDS;                         \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    int status = NAME##_rm_at_many(v, v->size - count, count);                 \
+    switch(status)                                                             \
+    {                                                                          \
+        case 0:                                                                \
+            return 0;                                                          \
+        default:                                                               \
+            return GENC_ERR_UNEXPECTED;                                        \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_many_shrink(struct NAME * v, size_t pos, size_t count)            \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if((pos > v->size) || (count > v->size - pos))                             \
+        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    int status = NAME##_rm_at_many(v, pos, count);                             \
+    if(status != 0) return GENC_ERR_UNEXPECTED;                                \
+                                                                               \
+    status = NAME##_shrink(v);                                                 \
+    switch(status)                                                             \
+    {                                                                          \
+        case 0:                                                                \
+            return 0;                                                          \
+        default:                                                               \
+            return GENC_ERR_UNEXPECTED;                                        \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many_shrink(struct NAME * v, size_t count)                         \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(count > v->size) return GENC_ERR_OUT_OF_BOUNDS;                         \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    int status = NAME##_rm_at_many_shrink(v, v->size - count, count);          \
+    switch(status)                                                             \
+    {                                                                          \
+        case 0:                                                                \
+            return 0;                                                          \
+        default:                                                               \
+            return GENC_ERR_UNEXPECTED;                                        \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_unchecked(struct NAME * v, TYPE data, size_t pos)                   \
+{                                                                              \
+    if(GENC_UNLIKELY(v->size == v->cap))                                       \
+    {                                                                          \
+        int status = NAME##__grow(v, v->size + 1);                             \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    TYPE * slot = v->data + pos;                                               \
+    if(pos != v->size)                                                         \
+        memmove(slot + 1, slot, (v->size - pos) * sizeof(TYPE));               \
+                                                                               \
+    *slot = data;                                                              \
+    ++(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_unchecked(struct NAME * v, TYPE data)                             \
+{                                                                              \
+    if(GENC_UNLIKELY(v->size == v->cap))                                       \
+    {                                                                          \
+        int status = NAME##__grow(v, v->size + 1);                             \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    v->data[v->size] = data;                                                   \
+    ++(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_unchecked(struct NAME * v, size_t pos)                            \
+{                                                                              \
+    TYPE * slot = v->data + pos;                                               \
+    memmove(slot, slot + 1, (v->size - pos - 1) * sizeof(TYPE));               \
+                                                                               \
+    --(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_unchecked(struct NAME * v)                                         \
+{                                                                              \
+    --(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins(struct NAME * v, TYPE data, size_t pos)                             \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos > v->size) return GENC_ERR_OUT_OF_BOUNDS;                           \
+                                                                               \
+    return NAME##_ins_unchecked(v, data, pos);                                 \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * v, TYPE data)                                       \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    return NAME##_pushb_unchecked(v, data);                                    \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at(struct NAME * v, size_t pos)                                      \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    return NAME##_rm_at_unchecked(v, pos);                                     \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * v)                                                   \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    return NAME##_popb_unchecked(v);                                           \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_emplace_back(struct NAME * v)                                           \
+{                                                                              \
+    if(!v) return NULL;                                                        \
+                                                                               \
+    if(GENC_UNLIKELY(v->size == v->cap))                                       \
+    {                                                                          \
+        if(NAME##__grow(v, v->size + 1) != 0) return NULL;                     \
+    }                                                                          \
+                                                                               \
+    return v->data + (v->size)++;                                              \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_reserve_back(struct NAME * v, size_t count)                             \
+{                                                                              \
+    if(!v || (count == 0)) return NULL;                                        \
+                                                                               \
+    if(GENC_UNLIKELY(count > v->cap - v->size))                                \
+    {                                                                          \
+        if(count > SIZE_MAX - v->size) return NULL;                            \
+        if(NAME##__grow(v, v->size + count) != 0) return NULL;                 \
+    }                                                                          \
+                                                                               \
+    return v->data + v->size;                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_commit_back(struct NAME * v, size_t count)                              \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(count > v->cap - v->size) return GENC_ERR_OUT_OF_BOUNDS;                \
+                                                                               \
+    v->size += count;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_remove_if(struct NAME * v, bool (*pred)(TYPE const * elem, void* ctx),  \
+                 void* ctx)                                                    \
+{                                                                              \
+    if(!v || !pred) return GENC_ERR_INV_ARG;                                   \
+                                                                               \
+    /* Elements before the first removed one stay where they are. */           \
+    size_t r = 0;                                                              \
+    while((r < v->size) && !pred(&v->data[r], ctx))                            \
+        ++r;                                                                   \
+                                                                               \
+    size_t w = r;                                                              \
+    for(r = r + 1; r < v->size; r++)                                           \
+    {                                                                          \
+        if(!pred(&v->data[r], ctx))                                            \
+        {                                                                      \
+            v->data[w] = v->data[r];                                           \
+            ++w;                                                               \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    v->size = w;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_swap_rm_at(struct NAME * v, size_t pos)                                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    --(v->size);                                                               \
+    if(pos != v->size)                                                         \
+        v->data[pos] = v->data[v->size];                                       \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_dedup_sorted(struct NAME * v,                                           \
+                    bool (*eq)(TYPE const * a, TYPE const * b))                \
+{                                                                              \
+    if(!v || !eq) return GENC_ERR_INV_ARG;                                     \
+                                                                               \
+    if(v->size < 2) return 0;                                                  \
+                                                                               \
+    size_t r = 1;                                                              \
+    while((r < v->size) && !eq(&v->data[r - 1], &v->data[r]))                  \
+        ++r;                                                                   \
+                                                                               \
+    size_t w = r;                                                              \
+    for(r = r + 1; r < v->size; r++)                                           \
+    {                                                                          \
+        if(!eq(&v->data[w - 1], &v->data[r]))                                  \
+        {                                                                      \
+            v->data[w] = v->data[r];                                           \
+            ++w;                                                               \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    v->size = w;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_remove_if_shrink(struct NAME * v,                                       \
+                        bool (*pred)(TYPE const * elem, void* ctx),            \
+                        void* ctx)                                             \
+{                                                                              \
+    int status = NAME##_remove_if(v, pred, ctx);                               \
+    if(status != 0) return status;                                             \
+                                                                               \
+    return NAME##_shrink(v);                                                   \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_swap_rm_at_shrink(struct NAME * v, size_t pos)                          \
+{                                                                              \
+    int status = NAME##_swap_rm_at(v, pos);                                    \
+    if(status != 0) return status;                                             \
+                                                                               \
+    return NAME##_shrink(v);                                                   \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_dedup_sorted_shrink(struct NAME * v,                                    \
+                           bool (*eq)(TYPE const * a, TYPE const * b))         \
+{                                                                              \
+    int status = NAME##_dedup_sorted(v, eq);                                   \
+    if(status != 0) return status;                                             \
+                                                                               \
+    return NAME##_shrink(v);                                                   \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at_shrink(struct NAME * v, size_t pos)                               \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    int status = NAME##_rm_at_many_shrink(v, pos, 1);                          \
+    switch(status)                                                             \
+    {                                                                          \
+        case 0:                                                                \
+            return 0;                                                          \
+        default:                                                               \
+            return GENC_ERR_UNEXPECTED;                                        \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_shrink(struct NAME * v)                                            \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    int status = NAME##_popb_many_shrink(v, 1);                                \
+    switch(status)                                                             \
+    {                                                                          \
+        case 0:                                                                \
+            return 0;                                                          \
+        default:                                                               \
+            return GENC_ERR_UNEXPECTED;                                        \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * v)                                                  \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    v->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty_shrink(struct NAME * v)                                           \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    FREE(v, v->data, v->cap * sizeof(TYPE));                                   \
+    v->data = NULL;                                                            \
+    v->cap = 0;                                                                \
+    v->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * v)                                                    \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(v->size == v->cap) return 0;                                            \
+                                                                               \
+    if(v->size == 0)                                                           \
+    {                                                                          \
+        FREE(v, v->data, v->cap * sizeof(TYPE));                               \
+        v->data = NULL;                                                        \
+        v->cap = 0;                                                            \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    void* new_data = REALLOC(v, v->data, v->cap * sizeof(TYPE),                \
+                             v->size * sizeof(TYPE));                          \
+    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+                                                                               \
+    v->data = new_data;                                                        \
+    v->cap = v->size;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * v, size_t size)                                  \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(size == 0) return 0;                                                    \
+                                                                               \
+    if(size > SIZE_MAX - v->cap)                                               \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    size_t new_cap = v->cap + size;                                            \
+    if(new_cap > SIZE_MAX / sizeof(TYPE))                                      \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    void* new_data = REALLOC(v, v->data, v->cap * sizeof(TYPE),                \
+                             new_cap * sizeof(TYPE));                          \
+    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+                                                                               \
+    v->data = new_data;                                                        \
+    v->cap = new_cap;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_VECTOR_INLINE(NAME, TYPE, GROWF)                                  \
+    GENC_VECTOR_DECLARE(NAME, TYPE, static inline)                             \
+    GENC_VECTOR_DEFINE(NAME, TYPE, GROWF, static inline)
+
+#define GENC_VECTOR_INLINE_ALLOC(NAME, TYPE, GROWF)                            \
+    GENC_VECTOR_DECLARE_ALLOC(NAME, TYPE, static inline)                       \
+    GENC_VECTOR_DEFINE_ALLOC(NAME, TYPE, GROWF, static inline)
+
+#define GENC_VECTOR_INLINE_MMAP(NAME, TYPE, GROWF)                             \
+    GENC_VECTOR_DECLARE(NAME, TYPE, static inline)                             \
+    GENC_VECTOR_DEFINE_MMAP(NAME, TYPE, GROWF, static inline)
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* SMALL VECTOR */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_SVEC_DECLARE() and GENC_SVEC_DEFINE() generate a type-safe dynamic
+ * vector API with inline storage for N elements. GENC_SVEC_INLINE() generates
+ * both with `static inline`.
+ *
+ * The API is the same as the one generated by GENC_VECTOR_DEFINE(). While the
+ * elements fit in the inline buffer, `data` points to `buf` and no heap memory
+ * is used. The elements spill to the heap once the vector outgrows the buffer,
+ * and move back when shrinking brings the capacity within N.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ * Because `data` may point into the structure itself, the structure must not
+ * be copied or moved while it is in use.
+ *
+ * N must be greater than 0. GROWF has the same meaning as for GENC_VECTOR. */
+
+/* ========================================================================== */
+/* SMALL VECTOR - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    <type>* data;
+    size_t size;
+    size_t cap;
+    <type> buf[N];
+};
+
+|----------------------------------------------------------|
+
+* All functions are identical to the ones of GENC_VECTOR.
+
+|-------------------------------------------------------- */
+
+/* Reallocation for small vectors: blocks that fit in `buf` live there,
+ * larger blocks live on the heap. */
+static inline void*
+genc_svec_realloc(void* buf, size_t buf_size, void* ptr,
+                  size_t old_size, size_t new_size)
+{
+    if(!ptr || (ptr == buf))
+    {
+        if(new_size <= buf_size) return buf;
+
+        void* new_ptr = malloc(new_size);
+        if(!new_ptr) return NULL;
+
+        if(ptr) memcpy(new_ptr, buf, old_size);
+
+        return new_ptr;
+    }
+
+    if(new_size <= buf_size)
+    {
+        memcpy(buf, ptr, new_size);
+        free(ptr);
+        return buf;
+    }
+
+    return realloc(ptr, new_size);
+}
+
+static inline void
+genc_svec_free(void* buf, void* ptr)
+{
+    if(ptr != buf) free(ptr);
+}
+
+#define GENC_MEM_SVEC_REALLOC(OWNER, PTR, OLD_SIZE, NEW_SIZE)                  \
+    genc_svec_realloc((OWNER)->buf, sizeof((OWNER)->buf), (PTR),               \
+                      (OLD_SIZE), (NEW_SIZE))
+#define GENC_MEM_SVEC_FREE(OWNER, PTR, SIZE)                                   \
+    genc_svec_free((OWNER)->buf, (PTR))
+
+/* ========================================================================== */
+/* SMALL VECTOR - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* SMALL VECTOR - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SVEC_DECLARE(NAME, TYPE, N, FN_PREFIX)                            \
+struct NAME                                                                    \
+{                                                                              \
+    TYPE * data;                                                               \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+    TYPE buf[N];                                                               \
+};                                                                             \
+                                                                               \
+GENC_VECTOR_DECLARE_FNS(NAME, TYPE, FN_PREFIX)
+
+/* -------------------------------------------------------------------------- */
+/* SMALL VECTOR - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SVEC_DEFINE(NAME, TYPE, N, GROWF, FN_PREFIX)                      \
+    GENC_VECTOR_DEFINE_IMPL(NAME, TYPE, GROWF, FN_PREFIX, N,                   \
+                            GENC_MEM_SVEC_REALLOC, GENC_MEM_SVEC_FREE)
+
+/* -------------------------------------------------------------------------- */
+/* SMALL VECTOR - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SVEC_INLINE(NAME, TYPE, N, GROWF)                                 \
+    GENC_SVEC_DECLARE(NAME, TYPE, N, static inline)                            \
+    GENC_SVEC_DEFINE(NAME, TYPE, N, GROWF, static inline)
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* SEGMENTED VECTOR */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_SEGVEC_DECLARE() and GENC_SEGVEC_DEFINE() generate a type-safe
+ * segmented vector API. GENC_SEGVEC_INLINE() generates both with
+ * `static inline`.
+ *
+ * Elements live in segments whose sizes double: segment `k` holds
+ * GENC_SEGVEC_FIRST << k elements. Growing allocates a new segment instead
+ * of reallocating, so elements are never copied or moved and pointers to
+ * them stay valid until the elements are removed. The segment holding index
+ * `i` is found with a single bit scan of `i + GENC_SEGVEC_FIRST`, which keeps
+ * indexing O(1).
+ *
+ * Elements can only be added and removed at the back.
+ *
+ * The generated structure must be zero-initialized before its first use. */
+
+/* Base-2 logarithm of the size of the first segment. */
+#ifndef GENC_SEGVEC_FIRST_SHIFT
+#define GENC_SEGVEC_FIRST_SHIFT 4
+#endif // GENC_SEGVEC_FIRST_SHIFT
+
+#define GENC_SEGVEC_FIRST ((size_t)1 << GENC_SEGVEC_FIRST_SHIFT)
+#define GENC_SEGVEC_MAX_SEGS (sizeof(size_t) * 8 - GENC_SEGVEC_FIRST_SHIFT)
+
+/* ========================================================================== */
+/* SEGMENTED VECTOR - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    <type>* segs[GENC_SEGVEC_MAX_SEGS];
+    size_t seg_count;
+    size_t size;
+    size_t cap;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the vector and frees all segments.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_deinit(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Returns a pointer to the element at `idx`. The pointer stays valid until
+* the element is removed.
+
+* RETURN VALUE: Pointer to the element, NULL if `idx` is out of bounds or
+* `vec` is NULL.
+
+<type>* <name>_at(struct <name>* vec, size_t idx);
+
+|----------------------------------------------------------|
+
+* Appends one element/`count` elements from `data` to the vector.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL, or `data` is NULL when `count` is nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_pushb(struct <name>* vec, <type> data);
+int <name>_pushb_many(struct <name>* vec, <type> const* data, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes the last element/the last `count` elements. Segments are kept; use
+* <name>_fit() to free them.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_NO_DATA: The vector is empty (<name>_popb()).
+* GENC_ERR_OUT_OF_BOUNDS: `count` is greater than the vector size
+* (<name>_popb_many()).
+
+int <name>_popb(struct <name>* vec);
+int <name>_popb_many(struct <name>* vec, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes all elements while retaining all segments.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_empty(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Frees the segments that hold no elements.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_fit(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Allocates segments so that `count` more elements fit.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_prealloc(struct <name>* vec, size_t count);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* SEGMENTED VECTOR - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* SEGMENTED VECTOR - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SEGVEC_DECLARE(NAME, TYPE, FN_PREFIX)                             \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    TYPE * segs[GENC_SEGVEC_MAX_SEGS];                                         \
+    size_t seg_count;                                                          \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * v);                                                \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_at(struct NAME * v, size_t idx);                                        \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * v, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_many(struct NAME * v, TYPE const * data, size_t count);           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * v);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many(struct NAME * v, size_t count);                               \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * v);                                                 \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * v);                                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * v, size_t count);                                \
+
+/* -------------------------------------------------------------------------- */
+/* SEGMENTED VECTOR - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SEGVEC_DEFINE(NAME, TYPE, FN_PREFIX)                              \
+                                                                               \
+static inline TYPE *                                                           \
+NAME##__slot(struct NAME * v, size_t idx)                                      \
+{                                                                              \
+    size_t pos = idx + GENC_SEGVEC_FIRST;                                      \
+    unsigned msb = genc_msb64(pos);                                            \
+                                                                               \
+    return v->segs[msb - GENC_SEGVEC_FIRST_SHIFT] +                            \
+        (pos ^ ((size_t)1 << msb));                                            \
+}                                                                              \
+                                                                               \
+/* Allocates segments until the capacity reaches `cap`. */                     \
+static inline int                                                              \
+NAME##__grow(struct NAME * v, size_t cap)                                      \
+{                                                                              \
+    while(v->cap < cap)                                                        \
+    {                                                                          \
+        if(v->seg_count == GENC_SEGVEC_MAX_SEGS)                               \
+            return GENC_ERR_ALLOC_FAIL;                                        \
+                                                                               \
+        size_t seg_size = GENC_SEGVEC_FIRST << v->seg_count;                   \
+        if((seg_size > SIZE_MAX / sizeof(TYPE)) ||                             \
+           (seg_size > SIZE_MAX - v->cap))                                     \
+            return GENC_ERR_ALLOC_FAIL;                                        \
+                                                                               \
+        TYPE * seg = malloc(seg_size * sizeof(TYPE));                          \
+        if(!seg) return GENC_ERR_ALLOC_FAIL;                                   \
+                                                                               \
+        v->segs[v->seg_count] = seg;                                           \
+        ++(v->seg_count);                                                      \
+        v->cap += seg_size;                                                    \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * v)                                                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < v->seg_count; i++)                                          \
+    {                                                                          \
+        free(v->segs[i]);                                                      \
+        v->segs[i] = NULL;                                                     \
+    }                                                                          \
+                                                                               \
+    v->seg_count = 0;                                                          \
+    v->size = 0;                                                               \
+    v->cap = 0;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_at(struct NAME * v, size_t idx)                                         \
+{                                                                              \
+    if(!v || (idx >= v->size)) return NULL;                                    \
+                                                                               \
+    return NAME##__slot(v, idx);                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * v, TYPE data)                                       \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(v->size == v->cap)                                                      \
+    {                                                                          \
+        int status = NAME##__grow(v, v->cap + 1);                              \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    *NAME##__slot(v, v->size) = data;                                          \
+    ++(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_many(struct NAME * v, TYPE const * data, size_t count)            \
+{                                                                              \
+    if(!v || (!data && (count > 0))) return GENC_ERR_INV_ARG;                  \
+                                                                               \
+    if(count > SIZE_MAX - v->size) return GENC_ERR_ALLOC_FAIL;                 \
+                                                                               \
+    int status = NAME##__grow(v, v->size + count);                             \
+    if(status != 0) return status;                                             \
+                                                                               \
+    /* Copy one segment-sized run at a time. */                                \
+    while(count > 0)                                                           \
+    {                                                                          \
+        size_t pos = v->size + GENC_SEGVEC_FIRST;                              \
+        unsigned msb = genc_msb64(pos);                                        \
+        size_t off = pos ^ ((size_t)1 << msb);                                 \
+        size_t room = ((size_t)1 << msb) - off;                                \
+        size_t run = (count < room) ? count : room;                            \
+                                                                               \
+        memcpy(v->segs[msb - GENC_SEGVEC_FIRST_SHIFT] + off, data,             \
+               run * sizeof(TYPE));                                            \
+                                                                               \
+        v->size += run;                                                        \
+        data += run;                                                           \
+        count -= run;                                                          \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * v)                                                   \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    --(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many(struct NAME * v, size_t count)                                \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(count > v->size) return GENC_ERR_OUT_OF_BOUNDS;                         \
+                                                                               \
+    v->size -= count;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * v)                                                  \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    v->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * v)                                                    \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t keep = (v->size > 0) ?                                              \
+        genc_msb64(v->size - 1 + GENC_SEGVEC_FIRST) -                          \
+        GENC_SEGVEC_FIRST_SHIFT + 1 : 0;                                       \
+                                                                               \
+    while(v->seg_count > keep)                                                 \
+    {                                                                          \
+        --(v->seg_count);                                                      \
+        free(v->segs[v->seg_count]);                                           \
+        v->segs[v->seg_count] = NULL;                                          \
+        v->cap -= GENC_SEGVEC_FIRST << v->seg_count;                           \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * v, size_t count)                                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(count > SIZE_MAX - v->size) return GENC_ERR_ALLOC_FAIL;                 \
+                                                                               \
+    return NAME##__grow(v, v->size + count);                                   \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* SEGMENTED VECTOR - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SEGVEC_INLINE(NAME, TYPE)                                         \
+    GENC_SEGVEC_DECLARE(NAME, TYPE, static inline)                             \
+    GENC_SEGVEC_DEFINE(NAME, TYPE, static inline)                              \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* SOA VECTOR */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_SOA_VECTOR_DECLARE() and GENC_SOA_VECTOR_DEFINE() generate a type-safe
+ * struct-of-arrays vector API. GENC_SOA_VECTOR_INLINE() generates both with
+ * `static inline`.
+ *
+ * The fields are given as an X-macro that applies its argument to every
+ * (type, name) pair:
+ *
+ *     #define REC_FIELDS(X) X(uint32_t, id) X(float, score) X(double, ts)
+ *     GENC_SOA_VECTOR_INLINE(rec_soa, REC_FIELDS, 2.0)
+ *
+ * Every field is stored in its own contiguous array, e.g. `vec.score`, so a
+ * loop over one field only touches that field's memory. All arrays share
+ * `size` and `cap`, and insertion and removal apply to all of them. A whole
+ * record is passed as a `struct <name>_row`.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ * GROWF has the same meaning as for GENC_VECTOR. */
+
+/* ========================================================================== */
+/* SOA VECTOR - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    <type 0>* <field 0>;
+    <type 1>* <field 1>;
+    ...
+    size_t size;
+    size_t cap;
+};
+
+struct <name>_row
+{
+    <type 0> <field 0>;
+    <type 1> <field 1>;
+    ...
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the vector and frees all arrays.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_deinit(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Inserts `row` at `pos`/appends `row` to the vector.
+* `pos` may equal the vector size to append the row.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is greater than the vector size.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_ins(struct <name>* vec, struct <name>_row row, size_t pos);
+int <name>_pushb(struct <name>* vec, struct <name>_row row);
+
+|----------------------------------------------------------|
+
+* Removes the row at `pos`. <name>_swap_rm_at() moves the last row into its
+* place instead of shifting the following rows.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is outside the vector.
+
+int <name>_rm_at(struct <name>* vec, size_t pos);
+int <name>_swap_rm_at(struct <name>* vec, size_t pos);
+
+|----------------------------------------------------------|
+
+* Removes the last row from the vector.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_NO_DATA: The vector is empty.
+
+int <name>_popb(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Copies the row at `pos` to `out`/overwrites it with `row`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` or `out` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is outside the vector.
+
+int <name>_get(struct <name>* vec, size_t pos, struct <name>_row* out);
+int <name>_set(struct <name>* vec, size_t pos, struct <name>_row row);
+
+|----------------------------------------------------------|
+
+* Removes all rows while retaining allocated capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_empty(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Shrinks allocated capacity to the current vector size.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_fit(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Increases vector capacity by `size` rows.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_prealloc(struct <name>* vec, size_t size);
+
+|-------------------------------------------------------- */
+
+/* Per-field statements expanded through the field X-macro. They refer to the
+ * locals of the generated functions. */
+
+#define GENC_SOA__MEMBER(TYPE, FIELD) TYPE * FIELD;
+#define GENC_SOA__ROW_MEMBER(TYPE, FIELD) TYPE FIELD;
+
+#define GENC_SOA__FREE(TYPE, FIELD)                                            \
+    free(v->FIELD);                                                            \
+    v->FIELD = NULL;
+
+#define GENC_SOA__REALLOC(TYPE, FIELD)                                         \
+    if(ok && (new_cap > SIZE_MAX / sizeof(TYPE)))                              \
+        ok = false;                                                            \
+    if(ok)                                                                     \
+    {                                                                          \
+        void* new_col = realloc(v->FIELD, new_cap * sizeof(TYPE));             \
+        if(new_col)                                                            \
+            v->FIELD = new_col;                                                \
+        else                                                                   \
+            ok = false;                                                        \
+    }
+
+#define GENC_SOA__STORE(TYPE, FIELD) v->FIELD[pos] = row.FIELD;
+#define GENC_SOA__LOAD(TYPE, FIELD) out->FIELD = v->FIELD[pos];
+#define GENC_SOA__MOVE_LAST(TYPE, FIELD) v->FIELD[pos] = v->FIELD[v->size];
+
+#define GENC_SOA__SHIFT_UP(TYPE, FIELD)                                        \
+    memmove(v->FIELD + pos + 1, v->FIELD + pos,                                \
+            (v->size - pos) * sizeof(TYPE));
+
+#define GENC_SOA__SHIFT_DOWN(TYPE, FIELD)                                      \
+    memmove(v->FIELD + pos, v->FIELD + pos + 1,                                \
+            (v->size - pos - 1) * sizeof(TYPE));
+
+/* ========================================================================== */
+/* SOA VECTOR - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* SOA VECTOR - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SOA_VECTOR_DECLARE(NAME, FIELDS, FN_PREFIX)                       \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    FIELDS(GENC_SOA__MEMBER)                                                   \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+};                                                                             \
+                                                                               \
+struct NAME##_row                                                              \
+{                                                                              \
+    FIELDS(GENC_SOA__ROW_MEMBER)                                               \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * v);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins(struct NAME * v, struct NAME##_row row, size_t pos);                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * v, struct NAME##_row row);                          \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at(struct NAME * v, size_t pos);                                     \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_swap_rm_at(struct NAME * v, size_t pos);                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * v);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_get(struct NAME * v, size_t pos, struct NAME##_row * out);              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_set(struct NAME * v, size_t pos, struct NAME##_row row);                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * v);                                                 \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * v);                                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * v, size_t size);                                 \
+
+/* -------------------------------------------------------------------------- */
+/* SOA VECTOR - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SOA_VECTOR_DEFINE(NAME, FIELDS, GROWF, FN_PREFIX)                 \
+                                                                               \
+/* Reallocates every array to `new_cap` rows. On failure, the arrays that      \
+ * were already reallocated keep their new size, so `cap` becomes the smaller  \
+ * of the old and the new capacity. */                                         \
+static inline int                                                              \
+NAME##__realloc(struct NAME * v, size_t new_cap)                               \
+{                                                                              \
+    bool ok = true;                                                            \
+                                                                               \
+    FIELDS(GENC_SOA__REALLOC)                                                  \
+                                                                               \
+    if(!ok)                                                                    \
+    {                                                                          \
+        if(new_cap < v->cap) v->cap = new_cap;                                 \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+    }                                                                          \
+                                                                               \
+    v->cap = new_cap;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static GENC_COLD int                                                           \
+NAME##__grow(struct NAME * v, size_t req_cap)                                  \
+{                                                                              \
+    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+                                                                               \
+    size_t new_cap = (size_t)((double)v->cap * growf_adj);                     \
+                                                                               \
+    if(new_cap < req_cap)                                                      \
+        new_cap = req_cap;                                                     \
+                                                                               \
+    return NAME##__realloc(v, new_cap);                                        \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * v)                                                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    FIELDS(GENC_SOA__FREE)                                                     \
+    v->size = 0;                                                               \
+    v->cap = 0;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins(struct NAME * v, struct NAME##_row row, size_t pos)                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos > v->size) return GENC_ERR_OUT_OF_BOUNDS;                           \
+                                                                               \
+    if(GENC_UNLIKELY(v->size == v->cap))                                       \
+    {                                                                          \
+        int status = NAME##__grow(v, v->size + 1);                             \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    if(pos != v->size)                                                         \
+    {                                                                          \
+        FIELDS(GENC_SOA__SHIFT_UP)                                             \
+    }                                                                          \
+                                                                               \
+    FIELDS(GENC_SOA__STORE)                                                    \
+    ++(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * v, struct NAME##_row row)                           \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    return NAME##_ins(v, row, v->size);                                        \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at(struct NAME * v, size_t pos)                                      \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    FIELDS(GENC_SOA__SHIFT_DOWN)                                               \
+    --(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_swap_rm_at(struct NAME * v, size_t pos)                                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    --(v->size);                                                               \
+    if(pos != v->size)                                                         \
+    {                                                                          \
+        FIELDS(GENC_SOA__MOVE_LAST)                                            \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * v)                                                   \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    --(v->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_get(struct NAME * v, size_t pos, struct NAME##_row * out)               \
+{                                                                              \
+    if(!v || !out) return GENC_ERR_INV_ARG;                                    \
+    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    FIELDS(GENC_SOA__LOAD)                                                     \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_set(struct NAME * v, size_t pos, struct NAME##_row row)                 \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    FIELDS(GENC_SOA__STORE)                                                    \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * v)                                                  \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    v->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * v)                                                    \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(v->size == v->cap) return 0;                                            \
+                                                                               \
+    if(v->size == 0)                                                           \
+    {                                                                          \
+        FIELDS(GENC_SOA__FREE)                                                 \
+        v->cap = 0;                                                            \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    return NAME##__realloc(v, v->size);                                        \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * v, size_t size)                                  \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(size == 0) return 0;                                                    \
+                                                                               \
+    if(size > SIZE_MAX - v->cap)                                               \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    return NAME##__realloc(v, v->cap + size);                                  \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* SOA VECTOR - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SOA_VECTOR_INLINE(NAME, FIELDS, GROWF)                            \
+    GENC_SOA_VECTOR_DECLARE(NAME, FIELDS, static inline)                       \
+    GENC_SOA_VECTOR_DEFINE(NAME, FIELDS, GROWF, static inline)                 \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* BIT VECTOR */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_BITVEC_DECLARE() and GENC_BITVEC_DEFINE() generate a dynamic bit
+ * vector API. GENC_BITVEC_INLINE() generates both with `static inline`.
+ *
+ * Bits are packed into 64-bit words. Bulk operations, counting and searching
+ * work a word at a time using genc_popcount64() and genc_ctz64(). `cap` is
+ * the capacity in words. Bits past `size` in the last used word are always 0.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ * GROWF has the same meaning as for GENC_VECTOR and applies to the number of
+ * words. */
+
+/* ========================================================================== */
+/* BIT VECTOR - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    uint64_t* words;
+    size_t size;
+    size_t cap;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the bit vector and frees allocated memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+
+int <name>_deinit(struct <name>* bv);
+
+|----------------------------------------------------------|
+
+* Sets the size to `size` bits. Added bits are 0.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_resize(struct <name>* bv, size_t size);
+
+|----------------------------------------------------------|
+
+* Appends a bit/removes the last bit.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed (<name>_pushb()).
+* GENC_ERR_NO_DATA: The bit vector is empty (<name>_popb()).
+
+int <name>_pushb(struct <name>* bv, bool bit);
+int <name>_popb(struct <name>* bv);
+
+|----------------------------------------------------------|
+
+* Returns the bit at `idx`.
+
+* RETURN VALUE: The bit, false if `bv` is NULL or `idx` is out of bounds.
+
+bool <name>_test(struct <name> const* bv, size_t idx);
+
+|----------------------------------------------------------|
+
+* Sets/clears the bit at `idx`, or `count` bits starting at `pos`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: The bit or range is outside the bit vector.
+
+int <name>_set(struct <name>* bv, size_t idx);
+int <name>_clear(struct <name>* bv, size_t idx);
+int <name>_set_range(struct <name>* bv, size_t pos, size_t count);
+int <name>_clear_range(struct <name>* bv, size_t pos, size_t count);
+
+|----------------------------------------------------------|
+
+* Combines `src` into `dst` word by word: `dst &= src`, `dst |= src`,
+* `dst ^= src` and `dst &= ~src` respectively.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `dst` or `src` is NULL, or their sizes differ.
+
+int <name>_and(struct <name>* dst, struct <name> const* src);
+int <name>_or(struct <name>* dst, struct <name> const* src);
+int <name>_xor(struct <name>* dst, struct <name> const* src);
+int <name>_andnot(struct <name>* dst, struct <name> const* src);
+
+|----------------------------------------------------------|
+
+* Returns the number of set bits.
+
+* RETURN VALUE: The number of set bits, 0 if `bv` is NULL.
+
+size_t <name>_popcount(struct <name> const* bv);
+
+|----------------------------------------------------------|
+
+* Returns the index of the first set bit/the first set bit at or after `pos`.
+
+* RETURN VALUE: Index of the bit, SIZE_MAX if there is none or `bv` is NULL.
+
+size_t <name>_find_first_set(struct <name> const* bv);
+size_t <name>_find_next_set(struct <name> const* bv, size_t pos);
+
+|----------------------------------------------------------|
+
+* <name>_rank() returns the number of set bits before `pos`. `pos` values
+* past the end count all bits. <name>_select() returns the index of the set
+* bit with rank `k`, i.e. the (`k` + 1)-th set bit.
+
+* RETURN VALUE: <name>_rank(): The number of bits, 0 if `bv` is NULL.
+* <name>_select(): Index of the bit, SIZE_MAX if there are not enough set
+* bits or `bv` is NULL.
+
+size_t <name>_rank(struct <name> const* bv, size_t pos);
+size_t <name>_select(struct <name> const* bv, size_t k);
+
+|----------------------------------------------------------|
+
+* Removes all bits while retaining allocated capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+
+int <name>_empty(struct <name>* bv);
+
+|----------------------------------------------------------|
+
+* Shrinks allocated capacity if it is large relative to the size. Shrinking is
+* best-effort. If the bit vector is empty, its storage is freed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+
+int <name>_shrink(struct <name>* bv);
+
+|----------------------------------------------------------|
+
+* Shrinks allocated capacity to the words in use.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_fit(struct <name>* bv);
+
+|----------------------------------------------------------|
+
+* Increases capacity by `count` bits, rounded up to whole words.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `bv` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_prealloc(struct <name>* bv, size_t count);
+
+|-------------------------------------------------------- */
+
+/* Word-level helpers shared by all bit vectors. `size` is in bits. */
+
+static inline size_t
+genc_bits_words(size_t size)
+{
+    return (size >> 6) + ((size & 63) != 0);
+}
+
+static inline void
+genc_bits_fill(uint64_t* words, size_t pos, size_t count, bool value)
+{
+    while(count > 0)
+    {
+        size_t off = pos & 63;
+        size_t run = ((64 - off) < count) ? (64 - off) : count;
+        uint64_t mask = (run == 64) ? ~(uint64_t)0 :
+                        ((((uint64_t)1 << run) - 1) << off);
+
+        if(value)
+            words[pos >> 6] |= mask;
+        else
+            words[pos >> 6] &= ~mask;
+
+        pos += run;
+        count -= run;
+    }
+}
+
+static inline size_t
+genc_bits_popcount(uint64_t const* words, size_t size)
+{
+    size_t count = 0;
+    size_t nwords = genc_bits_words(size);
+
+    size_t i;
+    for(i = 0; i < nwords; i++)
+        count += genc_popcount64(words[i]);
+
+    return count;
+}
+
+static inline size_t
+genc_bits_find_next(uint64_t const* words, size_t size, size_t pos)
+{
+    if(pos >= size) return SIZE_MAX;
+
+    size_t nwords = genc_bits_words(size);
+    size_t w = pos >> 6;
+    uint64_t word = words[w] & (~(uint64_t)0 << (pos & 63));
+
+    while(!word)
+    {
+        if(++w == nwords) return SIZE_MAX;
+        word = words[w];
+    }
+
+    return (w << 6) + genc_ctz64(word);
+}
+
+static inline size_t
+genc_bits_rank(uint64_t const* words, size_t size, size_t pos)
+{
+    if(pos > size) pos = size;
+
+    size_t count = 0;
+    size_t full = pos >> 6;
+
+    size_t i;
+    for(i = 0; i < full; i++)
+        count += genc_popcount64(words[i]);
+
+    if(pos & 63)
+        count += genc_popcount64(words[full] &
+                                 (((uint64_t)1 << (pos & 63)) - 1));
+
+    return count;
+}
+
+static inline size_t
+genc_bits_select(uint64_t const* words, size_t size, size_t k)
+{
+    size_t nwords = genc_bits_words(size);
+
+    size_t i;
+    for(i = 0; i < nwords; i++)
+    {
+        size_t count = genc_popcount64(words[i]);
+        if(k < count)
+        {
+            uint64_t word = words[i];
+            while(k-- > 0)
+                word &= word - 1;
+
+            return (i << 6) + genc_ctz64(word);
+        }
+        k -= count;
+    }
+
+    return SIZE_MAX;
+}
+
+/* ========================================================================== */
+/* BIT VECTOR - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* BIT VECTOR - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_BITVEC_DECLARE(NAME, FN_PREFIX)                                   \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    uint64_t* words;                                                           \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * b);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_resize(struct NAME * b, size_t size);                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * b, bool bit);                                       \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * b);                                                  \
+                                                                               \
+FN_PREFIX bool                                                                 \
+NAME##_test(struct NAME const * b, size_t idx);                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_set(struct NAME * b, size_t idx);                                       \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_clear(struct NAME * b, size_t idx);                                     \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_set_range(struct NAME * b, size_t pos, size_t count);                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_clear_range(struct NAME * b, size_t pos, size_t count);                 \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_and(struct NAME * dst, struct NAME const * src);                        \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_or(struct NAME * dst, struct NAME const * src);                         \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_xor(struct NAME * dst, struct NAME const * src);                        \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_andnot(struct NAME * dst, struct NAME const * src);                     \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_popcount(struct NAME const * b);                                        \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_find_first_set(struct NAME const * b);                                  \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_find_next_set(struct NAME const * b, size_t pos);                       \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_rank(struct NAME const * b, size_t pos);                                \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_select(struct NAME const * b, size_t k);                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * b);                                                 \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_shrink(struct NAME * b);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * b);                                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * b, size_t count);                                \
+
+/* -------------------------------------------------------------------------- */
+/* BIT VECTOR - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_BITVEC_DEFINE(NAME, GROWF, FN_PREFIX)                             \
+                                                                               \
+static inline int                                                              \
+NAME##__realloc(struct NAME * b, size_t new_cap)                               \
+{                                                                              \
+    if(new_cap > SIZE_MAX / sizeof(uint64_t))                                  \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    uint64_t* new_words = realloc(b->words, new_cap * sizeof(uint64_t));       \
+    if(!new_words) return GENC_ERR_ALLOC_FAIL;                                 \
+                                                                               \
+    b->words = new_words;                                                      \
+    b->cap = new_cap;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static GENC_COLD int                                                           \
+NAME##__grow(struct NAME * b, size_t req_cap)                                  \
+{                                                                              \
+    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+                                                                               \
+    size_t new_cap = (size_t)((double)b->cap * growf_adj);                     \
+                                                                               \
+    if(new_cap < req_cap)                                                      \
+        new_cap = req_cap;                                                     \
+                                                                               \
+    return NAME##__realloc(b, new_cap);                                        \
+}                                                                              \
+                                                                               \
+/* Clears the bits past `size` in the last used word. */                       \
+static inline void                                                             \
+NAME##__trim(struct NAME * b)                                                  \
+{                                                                              \
+    if(b->size & 63)                                                           \
+        b->words[b->size >> 6] &= ((uint64_t)1 << (b->size & 63)) - 1;         \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * b)                                                 \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    free(b->words);                                                            \
+    b->words = NULL;                                                           \
+    b->size = 0;                                                               \
+    b->cap = 0;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_resize(struct NAME * b, size_t size)                                    \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t old_words = genc_bits_words(b->size);                               \
+    size_t new_words = genc_bits_words(size);                                  \
+                                                                               \
+    if(new_words > b->cap)                                                     \
+    {                                                                          \
+        int status = NAME##__grow(b, new_words);                               \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    if(new_words > old_words)                                                  \
+    {                                                                          \
+        memset(b->words + old_words, 0,                                        \
+               (new_words - old_words) * sizeof(uint64_t));                    \
+    }                                                                          \
+                                                                               \
+    b->size = size;                                                            \
+    if(new_words > 0) NAME##__trim(b);                                         \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * b, bool bit)                                        \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t w = b->size >> 6;                                                   \
+    if((b->size & 63) == 0)                                                    \
+    {                                                                          \
+        if(GENC_UNLIKELY(w == b->cap))                                         \
+        {                                                                      \
+            int status = NAME##__grow(b, w + 1);                               \
+            if(status != 0) return status;                                     \
+        }                                                                      \
+        b->words[w] = 0;                                                       \
+    }                                                                          \
+                                                                               \
+    b->words[w] |= (uint64_t)bit << (b->size & 63);                            \
+    ++(b->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * b)                                                   \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+    if(b->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    --(b->size);                                                               \
+    b->words[b->size >> 6] &= ~((uint64_t)1 << (b->size & 63));                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX bool                                                                 \
+NAME##_test(struct NAME const * b, size_t idx)                                 \
+{                                                                              \
+    if(!b || (idx >= b->size)) return false;                                   \
+                                                                               \
+    return (b->words[idx >> 6] >> (idx & 63)) & 1;                             \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_set(struct NAME * b, size_t idx)                                        \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+    if(idx >= b->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    b->words[idx >> 6] |= (uint64_t)1 << (idx & 63);                           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_clear(struct NAME * b, size_t idx)                                      \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+    if(idx >= b->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    b->words[idx >> 6] &= ~((uint64_t)1 << (idx & 63));                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_set_range(struct NAME * b, size_t pos, size_t count)                    \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+    if((pos > b->size) || (count > b->size - pos))                             \
+        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+                                                                               \
+    genc_bits_fill(b->words, pos, count, true);                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_clear_range(struct NAME * b, size_t pos, size_t count)                  \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+    if((pos > b->size) || (count > b->size - pos))                             \
+        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+                                                                               \
+    genc_bits_fill(b->words, pos, count, false);                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_and(struct NAME * dst, struct NAME const * src)                         \
+{                                                                              \
+    if(!dst || !src || (dst->size != src->size)) return GENC_ERR_INV_ARG;      \
+                                                                               \
+    size_t i, n = genc_bits_words(dst->size);                                  \
+    for(i = 0; i < n; i++)                                                     \
+        dst->words[i] &= src->words[i];                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_or(struct NAME * dst, struct NAME const * src)                          \
+{                                                                              \
+    if(!dst || !src || (dst->size != src->size)) return GENC_ERR_INV_ARG;      \
+                                                                               \
+    size_t i, n = genc_bits_words(dst->size);                                  \
+    for(i = 0; i < n; i++)                                                     \
+        dst->words[i] |= src->words[i];                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_xor(struct NAME * dst, struct NAME const * src)                         \
+{                                                                              \
+    if(!dst || !src || (dst->size != src->size)) return GENC_ERR_INV_ARG;      \
+                                                                               \
+    size_t i, n = genc_bits_words(dst->size);                                  \
+    for(i = 0; i < n; i++)                                                     \
+        dst->words[i] ^= src->words[i];                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_andnot(struct NAME * dst, struct NAME const * src)                      \
+{                                                                              \
+    if(!dst || !src || (dst->size != src->size)) return GENC_ERR_INV_ARG;      \
+                                                                               \
+    size_t i, n = genc_bits_words(dst->size);                                  \
+    for(i = 0; i < n; i++)                                                     \
+        dst->words[i] &= ~src->words[i];                                       \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_popcount(struct NAME const * b)                                         \
+{                                                                              \
+    if(!b) return 0;                                                           \
+                                                                               \
+    return genc_bits_popcount(b->words, b->size);                              \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_find_first_set(struct NAME const * b)                                   \
+{                                                                              \
+    if(!b) return SIZE_MAX;                                                    \
+                                                                               \
+    return genc_bits_find_next(b->words, b->size, 0);                          \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_find_next_set(struct NAME const * b, size_t pos)                        \
+{                                                                              \
+    if(!b) return SIZE_MAX;                                                    \
+                                                                               \
+    return genc_bits_find_next(b->words, b->size, pos);                        \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_rank(struct NAME const * b, size_t pos)                                 \
+{                                                                              \
+    if(!b) return 0;                                                           \
+                                                                               \
+    return genc_bits_rank(b->words, b->size, pos);                             \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_select(struct NAME const * b, size_t k)                                 \
+{                                                                              \
+    if(!b) return SIZE_MAX;                                                    \
+                                                                               \
+    return genc_bits_select(b->words, b->size, k);                             \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * b)                                                  \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    b->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_shrink(struct NAME * b)                                                 \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(b->size == 0)                                                           \
+    {                                                                          \
+        free(b->words);                                                        \
+        b->words = NULL;                                                       \
+        b->cap = 0;                                                            \
+                                                                               \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+    size_t used = genc_bits_words(b->size);                                    \
+    size_t threshold = (size_t)((double)b->cap / growf_adj / growf_adj);       \
+                                                                               \
+    if(used < threshold)                                                       \
+    {                                                                          \
+        size_t new_cap = (size_t)((double)used * growf_adj);                   \
+        if(new_cap < used) new_cap = used;                                     \
+                                                                               \
+        (void)NAME##__realloc(b, new_cap);                                     \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_fit(struct NAME * b)                                                    \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t used = genc_bits_words(b->size);                                    \
+    if(used == b->cap) return 0;                                               \
+                                                                               \
+    if(used == 0)                                                              \
+    {                                                                          \
+        free(b->words);                                                        \
+        b->words = NULL;                                                       \
+        b->cap = 0;                                                            \
+                                                                               \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    return NAME##__realloc(b, used);                                           \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * b, size_t count)                                 \
+{                                                                              \
+    if(!b) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    size_t words = genc_bits_words(count);                                     \
+    if(words > SIZE_MAX - b->cap)                                              \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    return NAME##__realloc(b, b->cap + words);                                 \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* BIT VECTOR - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_BITVEC_INLINE(NAME, GROWF)                                        \
+    GENC_BITVEC_DECLARE(NAME, static inline)                                   \
+    GENC_BITVEC_DEFINE(NAME, GROWF, static inline)                             \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* VECTOR SORT */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* Sorting for vectors generated by GENC_VECTOR or GENC_SVEC. All functions
+ * are generated as `static inline` so the comparison is inlined instead of
+ * being called through a pointer, as with qsort().
+ *
+ * GENC_VECTOR_SORT_DEFINE(NAME, TYPE, LESS_EXPR) generates an introsort and a
+ * stable merge sort. LESS_EXPR is an expression over `a` and `b`, both of
+ * type `TYPE const*`, that is true if `*a` orders before `*b`, for example
+ * `a->id < b->id`.
+ *
+ * GENC_VECTOR_RADIX_SORT_DEFINE(NAME, TYPE, KEY_EXPR, KEY_BYTES) generates a
+ * stable LSD radix sort. KEY_EXPR is an expression over `a`, of type
+ * `TYPE const*`, that yields an unsigned integer key whose order is the
+ * desired order; only its low KEY_BYTES bytes are sorted on. The
+ * genc_sort_key_*() helpers map signed and floating-point values to such
+ * keys. */
+
+#define GENC_SORT_INSERTION_CUTOFF 16
+
+/* ========================================================================== */
+/* VECTOR SORT - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+* Sorts the vector with introsort: quicksort with median-of-three pivots,
+* insertion sort below GENC_SORT_INSERTION_CUTOFF elements and heapsort once
+* the recursion gets too deep. Not stable.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_sort(struct <name>* vec);
+
+|----------------------------------------------------------|
+
+* Sorts the vector with a stable merge sort. `scratch` must have room for at
+* least `vec->size / 2` elements.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL, or `scratch` is NULL when the vector has
+* more than one element.
+
+int <name>_stable_sort(struct <name>* vec, <type>* scratch);
+
+|----------------------------------------------------------|
+
+* Sorts the vector with a stable LSD radix sort, one byte per pass. Passes in
+* which all keys share the same byte are skipped. `scratch` must have room
+* for at least `vec->size` elements.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL, or `scratch` is NULL when the vector has
+* more than one element.
+
+int <name>_radix_sort(struct <name>* vec, <type>* scratch);
+
+|----------------------------------------------------------|
+
+* Map signed and floating-point values to unsigned keys with the same order.
+* NaNs with the sign bit clear order after +inf, others before -inf.
+
+uint64_t genc_sort_key_i32(int32_t val);
+uint64_t genc_sort_key_i64(int64_t val);
+uint64_t genc_sort_key_f32(float val);
+uint64_t genc_sort_key_f64(double val);
+
+|-------------------------------------------------------- */
+
+static inline uint64_t
+genc_sort_key_i32(int32_t val)
+{
+    return (uint32_t)val ^ UINT32_C(0x80000000);
+}
+
+static inline uint64_t
+genc_sort_key_i64(int64_t val)
+{
+    return (uint64_t)val ^ UINT64_C(0x8000000000000000);
+}
+
+static inline uint64_t
+genc_sort_key_f32(float val)
+{
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+
+    return (bits & UINT32_C(0x80000000)) ?
+        (uint32_t)~bits : (bits | UINT32_C(0x80000000));
+}
+
+static inline uint64_t
+genc_sort_key_f64(double val)
+{
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+
+    return (bits & UINT64_C(0x8000000000000000)) ?
+        ~bits : (bits | UINT64_C(0x8000000000000000));
+}
+
+/* ========================================================================== */
+/* VECTOR SORT - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SORT - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_VECTOR_SORT_DEFINE(NAME, TYPE, LESS_EXPR)                         \
+                                                                               \
+static inline bool                                                             \
+NAME##__less(TYPE const * a, TYPE const * b)                                   \
+{                                                                              \
+    return (LESS_EXPR);                                                        \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__swap(TYPE * a, TYPE * b)                                               \
+{                                                                              \
+    TYPE tmp = *a;                                                             \
+    *a = *b;                                                                   \
+    *b = tmp;                                                                  \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__insertion_sort(TYPE * data, size_t count)                              \
+{                                                                              \
+    size_t i;                                                                  \
+    for(i = 1; i < count; i++)                                                 \
+    {                                                                          \
+        TYPE tmp = data[i];                                                    \
+        size_t j = i;                                                          \
+                                                                               \
+        while((j > 0) && NAME##__less(&tmp, &data[j - 1]))                     \
+        {                                                                      \
+            data[j] = data[j - 1];                                             \
+            --j;                                                               \
+        }                                                                      \
+                                                                               \
+        data[j] = tmp;                                                         \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__sift_down(TYPE * data, size_t pos, size_t count)                       \
+{                                                                              \
+    for(;;)                                                                    \
+    {                                                                          \
+        size_t child = 2 * pos + 1;                                            \
+        if(child >= count) break;                                              \
+                                                                               \
+        if((child + 1 < count) &&                                              \
+           NAME##__less(&data[child], &data[child + 1]))                       \
+            ++child;                                                           \
+                                                                               \
+        if(!NAME##__less(&data[pos], &data[child])) break;                     \
+                                                                               \
+        NAME##__swap(&data[pos], &data[child]);                                \
+        pos = child;                                                           \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__heap_sort(TYPE * data, size_t count)                                   \
+{                                                                              \
+    size_t i;                                                                  \
+    for(i = count / 2; i > 0; i--)                                             \
+        NAME##__sift_down(data, i - 1, count);                                 \
+                                                                               \
+    for(i = count; i > 1; i--)                                                 \
+    {                                                                          \
+        NAME##__swap(&data[0], &data[i - 1]);                                  \
+        NAME##__sift_down(data, 0, i - 1);                                     \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__intro_sort(TYPE * data, size_t count, size_t depth)                    \
+{                                                                              \
+    while(count > GENC_SORT_INSERTION_CUTOFF)                                  \
+    {                                                                          \
+        if(depth == 0)                                                         \
+        {                                                                      \
+            NAME##__heap_sort(data, count);                                    \
+            return;                                                            \
+        }                                                                      \
+        --depth;                                                               \
+                                                                               \
+        size_t mid = count / 2;                                                \
+        TYPE * lo = &data[0];                                                  \
+        TYPE * md = &data[mid];                                                \
+        TYPE * hi = &data[count - 1];                                          \
+                                                                               \
+        if(NAME##__less(md, lo)) NAME##__swap(md, lo);                         \
+        if(NAME##__less(hi, md))                                               \
+        {                                                                      \
+            NAME##__swap(hi, md);                                              \
+            if(NAME##__less(md, lo)) NAME##__swap(md, lo);                     \
+        }                                                                      \
+                                                                               \
+        /* Hoare partition around the median; both halves are non-empty. */    \
+        TYPE pivot = *md;                                                      \
+        size_t i = 0;                                                          \
+        size_t j = count - 1;                                                  \
+        for(;;)                                                                \
+        {                                                                      \
+            while(NAME##__less(&data[i], &pivot)) ++i;                         \
+            while(NAME##__less(&pivot, &data[j])) --j;                         \
+            if(i >= j) break;                                                  \
+                                                                               \
+            NAME##__swap(&data[i], &data[j]);                                  \
+            ++i;                                                               \
+            --j;                                                               \
+        }                                                                      \
+                                                                               \
+        size_t split = j + 1;                                                  \
+                                                                               \
+        /* Recurse into the smaller part to bound the stack depth. */          \
+        if(split < count - split)                                              \
+        {                                                                      \
+            NAME##__intro_sort(data, split, depth);                            \
+            data += split;                                                     \
+            count -= split;                                                    \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            NAME##__intro_sort(data + split, count - split, depth);            \
+            count = split;                                                     \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    NAME##__insertion_sort(data, count);                                       \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__merge_sort(TYPE * data, size_t count, TYPE * scratch)                  \
+{                                                                              \
+    if(count <= GENC_SORT_INSERTION_CUTOFF)                                    \
+    {                                                                          \
+        NAME##__insertion_sort(data, count);                                   \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    size_t mid = count / 2;                                                    \
+    NAME##__merge_sort(data, mid, scratch);                                    \
+    NAME##__merge_sort(data + mid, count - mid, scratch);                      \
+                                                                               \
+    if(!NAME##__less(&data[mid], &data[mid - 1])) return;                      \
+                                                                               \
+    memcpy(scratch, data, mid * sizeof(TYPE));                                 \
+                                                                               \
+    size_t i = 0, j = mid, k = 0;                                              \
+    while((i < mid) && (j < count))                                            \
+    {                                                                          \
+        if(NAME##__less(&data[j], &scratch[i]))                                \
+            data[k++] = data[j++];                                             \
+        else                                                                   \
+            data[k++] = scratch[i++];                                          \
+    }                                                                          \
+                                                                               \
+    memcpy(&data[k], &scratch[i], (mid - i) * sizeof(TYPE));                   \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_sort(struct NAME * v)                                                   \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t depth = 0;                                                          \
+    size_t n;                                                                  \
+    for(n = v->size; n > 1; n >>= 1)                                           \
+        depth += 2;                                                            \
+                                                                               \
+    NAME##__intro_sort(v->data, v->size, depth);                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_stable_sort(struct NAME * v, TYPE * scratch)                            \
+{                                                                              \
+    if(!v || (!scratch && (v->size > 1))) return GENC_ERR_INV_ARG;             \
+                                                                               \
+    NAME##__merge_sort(v->data, v->size, scratch);                             \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SORT - RADIX */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_VECTOR_RADIX_SORT_DEFINE(NAME, TYPE, KEY_EXPR, KEY_BYTES)         \
+                                                                               \
+static inline uint64_t                                                         \
+NAME##__radix_key(TYPE const * a)                                              \
+{                                                                              \
+    return (uint64_t)(KEY_EXPR);                                               \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_radix_sort(struct NAME * v, TYPE * scratch)                             \
+{                                                                              \
+    if(!v || (!scratch && (v->size > 1))) return GENC_ERR_INV_ARG;             \
+                                                                               \
+    size_t count = v->size;                                                    \
+    if(count < 2) return 0;                                                    \
+                                                                               \
+    TYPE * src = v->data;                                                      \
+    TYPE * dst = scratch;                                                      \
+                                                                               \
+    unsigned pass;                                                             \
+    for(pass = 0; pass < (unsigned)(KEY_BYTES); pass++)                        \
+    {                                                                          \
+        unsigned shift = pass * 8;                                             \
+        size_t hist[256] = { 0 };                                              \
+                                                                               \
+        size_t i;                                                              \
+        for(i = 0; i < count; i++)                                             \
+            ++hist[(NAME##__radix_key(&src[i]) >> shift) & 0xFF];              \
+                                                                               \
+        /* All keys share this byte: the pass would not reorder anything. */   \
+        if(hist[(NAME##__radix_key(&src[0]) >> shift) & 0xFF] == count)        \
+            continue;                                                          \
+                                                                               \
+        size_t sum = 0;                                                        \
+        for(i = 0; i < 256; i++)                                               \
+        {                                                                      \
+            size_t tmp = hist[i];                                              \
+            hist[i] = sum;                                                     \
+            sum += tmp;                                                        \
+        }                                                                      \
+                                                                               \
+        for(i = 0; i < count; i++)                                             \
+        {                                                                      \
+            size_t byte = (NAME##__radix_key(&src[i]) >> shift) & 0xFF;        \
+            dst[hist[byte]++] = src[i];                                        \
+        }                                                                      \
+                                                                               \
+        TYPE * tmp = src;                                                      \
+        src = dst;                                                             \
+        dst = tmp;                                                             \
+    }                                                                          \
+                                                                               \
+    if(src != v->data)                                                         \
+        memcpy(v->data, src, count * sizeof(TYPE));                            \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* Vectorized scans for vectors generated by GENC_VECTOR or GENC_SVEC whose
+ * TYPE is a fixed-width scalar. GENC_VECTOR_SIMD_DEFINE(NAME, TYPE, KIND)
+ * generates `static inline` functions on top of shared kernels, where KIND
+ * names the element type:
+ *
+ * i32: int32_t, u32: uint32_t, i64: int64_t, u64: uint64_t, f32: float,
+ * f64: double.
+ *
+ * TYPE must be that type or one with the same size and representation, as
+ * the kernels access the data through it.
+ *
+ * The kernels use SSE2 when it is available (GENC_HAS_SSE2) and fall back to
+ * scalar loops otherwise. With GCC and Clang on x86, AVX2 versions are also
+ * compiled and used when the CPU supports them (GENC_HAS_AVX2_DISPATCH).
+ *
+ * Sums of floating-point elements are accumulated in double precision, in an
+ * order that differs from a sequential loop. Minimum and maximum are
+ * unspecified if the vector contains NaNs. Sums of integer elements wrap
+ * around on overflow. */
+
+/* ========================================================================== */
+/* VECTOR SIMD - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+* Returns the index of the first element equal to `val`.
+
+* RETURN VALUE: Index of the element, SIZE_MAX if there is none or `vec` is
+* NULL.
+
+size_t <name>_find(struct <name>* vec, <type> val);
+
+|----------------------------------------------------------|
+
+* Returns the number of elements equal to `val`.
+
+* RETURN VALUE: Number of elements, 0 if `vec` is NULL.
+
+size_t <name>_count(struct <name>* vec, <type> val);
+
+|----------------------------------------------------------|
+
+* Sets all elements to `val`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL.
+
+int <name>_fill(struct <name>* vec, <type> val);
+
+|----------------------------------------------------------|
+
+* Stores the smallest/largest element into `out`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` or `out` is NULL.
+* GENC_ERR_NO_DATA: The vector is empty.
+
+int <name>_min(struct <name>* vec, <type>* out);
+int <name>_max(struct <name>* vec, <type>* out);
+
+|----------------------------------------------------------|
+
+* Stores the sum of the elements into `out`. The sum type is int64_t for i32
+* and i64, uint64_t for u32 and u64, and double for f32 and f64.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` or `out` is NULL.
+
+int <name>_sum(struct <name>* vec, genc_simd_<kind>_sum_t* out);
+
+|-------------------------------------------------------- */
+
+typedef int32_t genc_simd_i32_t;
+typedef uint32_t genc_simd_u32_t;
+typedef int64_t genc_simd_i64_t;
+typedef uint64_t genc_simd_u64_t;
+typedef float genc_simd_f32_t;
+typedef double genc_simd_f64_t;
+
+typedef int64_t genc_simd_i32_sum_t;
+typedef uint64_t genc_simd_u32_sum_t;
+typedef int64_t genc_simd_i64_sum_t;
+typedef uint64_t genc_simd_u64_sum_t;
+typedef double genc_simd_f32_sum_t;
+typedef double genc_simd_f64_sum_t;
+
+/* Integer sums are accumulated unsigned so that overflow wraps around. */
+typedef uint64_t genc_simd_i32_acc_t;
+typedef uint64_t genc_simd_u32_acc_t;
+typedef uint64_t genc_simd_i64_acc_t;
+typedef uint64_t genc_simd_u64_acc_t;
+typedef double genc_simd_f32_acc_t;
+typedef double genc_simd_f64_acc_t;
+
+/* ========================================================================== */
+/* VECTOR SIMD - KERNEL GENERATORS */
+/* ========================================================================== */
+
+#define GENC_SIMD_SCALAR_KERNELS(KIND)                                         \
+                                                                               \
+static inline size_t                                                           \
+genc_scalar_find_##KIND(genc_simd_##KIND##_t const* data, size_t count,        \
+                        genc_simd_##KIND##_t val)                              \
+{                                                                              \
+    size_t i;                                                                  \
+    for(i = 0; i < count; i++)                                                 \
+    {                                                                          \
+        if(data[i] == val) return i;                                           \
+    }                                                                          \
+                                                                               \
+    return SIZE_MAX;                                                           \
+}                                                                              \
+                                                                               \
+static inline size_t                                                           \
+genc_scalar_count_##KIND(genc_simd_##KIND##_t const* data, size_t count,       \
+                         genc_simd_##KIND##_t val)                             \
+{                                                                              \
+    size_t n = 0;                                                              \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < count; i++)                                                 \
+        n += (data[i] == val);                                                 \
+                                                                               \
+    return n;                                                                  \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+genc_scalar_fill_##KIND(genc_simd_##KIND##_t* data, size_t count,              \
+                        genc_simd_##KIND##_t val)                              \
+{                                                                              \
+    size_t i;                                                                  \
+    for(i = 0; i < count; i++)                                                 \
+        data[i] = val;                                                         \
+}                                                                              \
+                                                                               \
+/* `count` must be nonzero. */                                                 \
+static inline genc_simd_##KIND##_t                                             \
+genc_scalar_min_##KIND(genc_simd_##KIND##_t const* data, size_t count)         \
+{                                                                              \
+    genc_simd_##KIND##_t res = data[0];                                        \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 1; i < count; i++)                                                 \
+    {                                                                          \
+        if(data[i] < res) res = data[i];                                       \
+    }                                                                          \
+                                                                               \
+    return res;                                                                \
+}                                                                              \
+                                                                               \
+/* `count` must be nonzero. */                                                 \
+static inline genc_simd_##KIND##_t                                             \
+genc_scalar_max_##KIND(genc_simd_##KIND##_t const* data, size_t count)         \
+{                                                                              \
+    genc_simd_##KIND##_t res = data[0];                                        \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 1; i < count; i++)                                                 \
+    {                                                                          \
+        if(data[i] > res) res = data[i];                                       \
+    }                                                                          \
+                                                                               \
+    return res;                                                                \
+}                                                                              \
+                                                                               \
+static inline genc_simd_##KIND##_acc_t                                         \
+genc_scalar_sum_##KIND(genc_simd_##KIND##_t const* data, size_t count)         \
+{                                                                              \
+    genc_simd_##KIND##_acc_t sum = 0;                                          \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < count; i++)                                                 \
+        sum += (genc_simd_##KIND##_acc_t)data[i];                              \
+                                                                               \
+    return sum;                                                                \
+}                                                                              \
+
+/* Generates the kernels of instruction set ISA from its primitives:
+ * genc_<isa>_{load,store,set1,eqmask,vmin,vmax}_<kind>() on VEC, and
+ * genc_<isa>_acc_{zero,add,reduce}_<kind>() on ACC. Each primitive handles
+ * LANES elements. Tails are handled by overlapping the last full vector where
+ * that is harmless, and by the scalar kernels otherwise. */
+#define GENC_SIMD_VECTOR_KERNELS(ISA, KIND, ATTR, VEC, ACC, LANES)             \
+                                                                               \
+ATTR static inline size_t                                                      \
+genc_##ISA##_find_##KIND(genc_simd_##KIND##_t const* data, size_t count,       \
+                         genc_simd_##KIND##_t val)                             \
+{                                                                              \
+    if(count < (LANES))                                                        \
+        return genc_scalar_find_##KIND(data, count, val);                      \
+                                                                               \
+    VEC needle = genc_##ISA##_set1_##KIND(val);                                \
+    unsigned mask;                                                             \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i + (LANES) <= count; i += (LANES))                             \
+    {                                                                          \
+        mask = genc_##ISA##_eqmask_##KIND(data + i, needle);                   \
+        if(mask) return i + genc_ctz32(mask);                                  \
+    }                                                                          \
+                                                                               \
+    if(i == count) return SIZE_MAX;                                            \
+                                                                               \
+    i = count - (LANES);                                                       \
+    mask = genc_##ISA##_eqmask_##KIND(data + i, needle);                       \
+                                                                               \
+    return mask ? (i + genc_ctz32(mask)) : SIZE_MAX;                           \
+}                                                                              \
+                                                                               \
+ATTR static inline size_t                                                      \
+genc_##ISA##_count_##KIND(genc_simd_##KIND##_t const* data, size_t count,      \
+                          genc_simd_##KIND##_t val)                            \
+{                                                                              \
+    VEC needle = genc_##ISA##_set1_##KIND(val);                                \
+    size_t n = 0;                                                              \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i + (LANES) <= count; i += (LANES))                             \
+        n += genc_popcount32(genc_##ISA##_eqmask_##KIND(data + i, needle));    \
+                                                                               \
+    return n + genc_scalar_count_##KIND(data + i, count - i, val);             \
+}                                                                              \
+                                                                               \
+ATTR static inline void                                                        \
+genc_##ISA##_fill_##KIND(genc_simd_##KIND##_t* data, size_t count,             \
+                         genc_simd_##KIND##_t val)                             \
+{                                                                              \
+    if(count < (LANES))                                                        \
+    {                                                                          \
+        genc_scalar_fill_##KIND(data, count, val);                             \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    VEC vval = genc_##ISA##_set1_##KIND(val);                                  \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i + (LANES) <= count; i += (LANES))                             \
+        genc_##ISA##_store_##KIND(data + i, vval);                             \
+                                                                               \
+    if(i < count)                                                              \
+        genc_##ISA##_store_##KIND(data + count - (LANES), vval);               \
+}                                                                              \
+                                                                               \
+ATTR static inline genc_simd_##KIND##_t                                        \
+genc_##ISA##_min_##KIND(genc_simd_##KIND##_t const* data, size_t count)        \
+{                                                                              \
+    if(count < (LANES))                                                        \
+        return genc_scalar_min_##KIND(data, count);                            \
+                                                                               \
+    VEC acc = genc_##ISA##_load_##KIND(data);                                  \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = (LANES); i + (LANES) <= count; i += (LANES))                       \
+        acc = genc_##ISA##_vmin_##KIND(acc,                                    \
+                                       genc_##ISA##_load_##KIND(data + i));    \
+                                                                               \
+    acc = genc_##ISA##_vmin_##KIND(acc,                                        \
+        genc_##ISA##_load_##KIND(data + count - (LANES)));                     \
+                                                                               \
+    genc_simd_##KIND##_t lanes[LANES];                                         \
+    genc_##ISA##_store_##KIND(lanes, acc);                                     \
+                                                                               \
+    return genc_scalar_min_##KIND(lanes, (LANES));                             \
+}                                                                              \
+                                                                               \
+ATTR static inline genc_simd_##KIND##_t                                        \
+genc_##ISA##_max_##KIND(genc_simd_##KIND##_t const* data, size_t count)        \
+{                                                                              \
+    if(count < (LANES))                                                        \
+        return genc_scalar_max_##KIND(data, count);                            \
+                                                                               \
+    VEC acc = genc_##ISA##_load_##KIND(data);                                  \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = (LANES); i + (LANES) <= count; i += (LANES))                       \
+        acc = genc_##ISA##_vmax_##KIND(acc,                                    \
+                                       genc_##ISA##_load_##KIND(data + i));    \
+                                                                               \
+    acc = genc_##ISA##_vmax_##KIND(acc,                                        \
+        genc_##ISA##_load_##KIND(data + count - (LANES)));                     \
+                                                                               \
+    genc_simd_##KIND##_t lanes[LANES];                                         \
+    genc_##ISA##_store_##KIND(lanes, acc);                                     \
+                                                                               \
+    return genc_scalar_max_##KIND(lanes, (LANES));                             \
+}                                                                              \
+                                                                               \
+ATTR static inline genc_simd_##KIND##_acc_t                                    \
+genc_##ISA##_sum_##KIND(genc_simd_##KIND##_t const* data, size_t count)        \
+{                                                                              \
+    ACC acc = genc_##ISA##_acc_zero_##KIND();                                  \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i + (LANES) <= count; i += (LANES))                             \
+        acc = genc_##ISA##_acc_add_##KIND(acc, data + i);                      \
+                                                                               \
+    return genc_##ISA##_acc_reduce_##KIND(acc) +                               \
+        genc_scalar_sum_##KIND(data + i, count - i);                           \
+}                                                                              \
+
+/* Selects the widest kernel the CPU supports. */
+#define GENC_SIMD_DISPATCH(KIND)                                               \
+                                                                               \
+static inline size_t                                                           \
+genc_simd_find_##KIND(genc_simd_##KIND##_t const* data, size_t count,          \
+                      genc_simd_##KIND##_t val)                                \
+{                                                                              \
+    return genc_simd_has_avx2() ?                                              \
+        GENC_SIMD_WIDE(find, KIND)(data, count, val) :                         \
+        GENC_SIMD_BASE(find, KIND)(data, count, val);                          \
+}                                                                              \
+                                                                               \
+static inline size_t                                                           \
+genc_simd_count_##KIND(genc_simd_##KIND##_t const* data, size_t count,         \
+                       genc_simd_##KIND##_t val)                               \
+{                                                                              \
+    return genc_simd_has_avx2() ?                                              \
+        GENC_SIMD_WIDE(count, KIND)(data, count, val) :                        \
+        GENC_SIMD_BASE(count, KIND)(data, count, val);                         \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+genc_simd_fill_##KIND(genc_simd_##KIND##_t* data, size_t count,                \
+                      genc_simd_##KIND##_t val)                                \
+{                                                                              \
+    if(genc_simd_has_avx2())                                                   \
+        GENC_SIMD_WIDE(fill, KIND)(data, count, val);                          \
+    else                                                                       \
+        GENC_SIMD_BASE(fill, KIND)(data, count, val);                          \
+}                                                                              \
+                                                                               \
+static inline genc_simd_##KIND##_t                                             \
+genc_simd_min_##KIND(genc_simd_##KIND##_t const* data, size_t count)           \
+{                                                                              \
+    return genc_simd_has_avx2() ?                                              \
+        GENC_SIMD_WIDE(min, KIND)(data, count) :                               \
+        GENC_SIMD_BASE(min, KIND)(data, count);                                \
+}                                                                              \
+                                                                               \
+static inline genc_simd_##KIND##_t                                             \
+genc_simd_max_##KIND(genc_simd_##KIND##_t const* data, size_t count)           \
+{                                                                              \
+    return genc_simd_has_avx2() ?                                              \
+        GENC_SIMD_WIDE(max, KIND)(data, count) :                               \
+        GENC_SIMD_BASE(max, KIND)(data, count);                                \
+}                                                                              \
+                                                                               \
+static inline genc_simd_##KIND##_acc_t                                         \
+genc_simd_sum_##KIND(genc_simd_##KIND##_t const* data, size_t count)           \
+{                                                                              \
+    return genc_simd_has_avx2() ?                                              \
+        GENC_SIMD_WIDE(sum, KIND)(data, count) :                               \
+        GENC_SIMD_BASE(sum, KIND)(data, count);                                \
+}                                                                              \
+
+/* ========================================================================== */
+/* VECTOR SIMD - SCALAR KERNELS */
+/* ========================================================================== */
+
+GENC_SIMD_SCALAR_KERNELS(i32)
+GENC_SIMD_SCALAR_KERNELS(u32)
+GENC_SIMD_SCALAR_KERNELS(i64)
+GENC_SIMD_SCALAR_KERNELS(u64)
+GENC_SIMD_SCALAR_KERNELS(f32)
+GENC_SIMD_SCALAR_KERNELS(f64)
+
+/* ========================================================================== */
+/* VECTOR SIMD - SSE2 KERNELS */
+/* ========================================================================== */
+
+#ifdef GENC_HAS_SSE2
+
+#define GENC_SSE2_LOADI(P) _mm_loadu_si128((__m128i const*)(void const*)(P))
+#define GENC_SSE2_STOREI(P, V) _mm_storeu_si128((__m128i*)(void*)(P), (V))
+
+/* Selects `b` where `mask` is set and `a` elsewhere. */
+static inline __m128i
+genc_sse2_select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, b), _mm_andnot_si128(mask, a));
+}
+
+/* Signed 64-bit `a > b`, which SSE2 lacks: compare the high halves signed
+ * and, where they are equal, the low halves unsigned. */
+static inline __m128i
+genc_sse2_cmpgt_i64(__m128i a, __m128i b)
+{
+    __m128i lo_bias = _mm_set_epi32(0, INT32_MIN, 0, INT32_MIN);
+    __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(a, lo_bias),
+                                 _mm_xor_si128(b, lo_bias));
+    __m128i eq = _mm_cmpeq_epi32(a, b);
+
+    __m128i hi_gt = _mm_shuffle_epi32(gt, _MM_SHUFFLE(3, 3, 1, 1));
+    __m128i hi_eq = _mm_shuffle_epi32(eq, _MM_SHUFFLE(3, 3, 1, 1));
+    __m128i lo_gt = _mm_shuffle_epi32(gt, _MM_SHUFFLE(2, 2, 0, 0));
+
+    return _mm_or_si128(hi_gt, _mm_and_si128(hi_eq, lo_gt));
+}
+
+static inline uint64_t
+genc_sse2_reduce_u64(__m128i acc)
+{
+    uint64_t lanes[2];
+    GENC_SSE2_STOREI(lanes, acc);
+
+    return lanes[0] + lanes[1];
+}
+
+static inline double
+genc_sse2_reduce_f64(__m128d acc)
+{
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+
+    return lanes[0] + lanes[1];
+}
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD - SSE2 - 32-BIT INTEGERS */
+/* -------------------------------------------------------------------------- */
+
+static inline __m128i
+genc_sse2_load_i32(int32_t const* p) { return GENC_SSE2_LOADI(p); }
+
+static inline void
+genc_sse2_store_i32(int32_t* p, __m128i v) { GENC_SSE2_STOREI(p, v); }
+
+static inline __m128i
+genc_sse2_set1_i32(int32_t val) { return _mm_set1_epi32(val); }
+
+static inline unsigned
+genc_sse2_eqmask_i32(int32_t const* p, __m128i needle)
+{
+    __m128i eq = _mm_cmpeq_epi32(GENC_SSE2_LOADI(p), needle);
+
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+
+static inline __m128i
+genc_sse2_vmin_i32(__m128i a, __m128i b)
+{
+    return genc_sse2_select(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+static inline __m128i
+genc_sse2_vmax_i32(__m128i a, __m128i b)
+{
+    return genc_sse2_select(_mm_cmpgt_epi32(b, a), a, b);
+}
+
+static inline __m128i
+genc_sse2_acc_zero_i32(void) { return _mm_setzero_si128(); }
+
+static inline __m128i
+genc_sse2_acc_add_i32(__m128i acc, int32_t const* p)
+{
+    __m128i val = GENC_SSE2_LOADI(p);
+    __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), val);
+
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(val, sign));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(val, sign));
+}
+
+static inline uint64_t
+genc_sse2_acc_reduce_i32(__m128i acc) { return genc_sse2_reduce_u64(acc); }
+
+static inline __m128i
+genc_sse2_load_u32(uint32_t const* p) { return GENC_SSE2_LOADI(p); }
+
+static inline void
+genc_sse2_store_u32(uint32_t* p, __m128i v) { GENC_SSE2_STOREI(p, v); }
+
+static inline __m128i
+genc_sse2_set1_u32(uint32_t val) { return _mm_set1_epi32((int32_t)val); }
+
+static inline unsigned
+genc_sse2_eqmask_u32(uint32_t const* p, __m128i needle)
+{
+    return genc_sse2_eqmask_i32((int32_t const*)(void const*)p, needle);
+}
+
+static inline __m128i
+genc_sse2_vmin_u32(__m128i a, __m128i b)
+{
+    __m128i bias = _mm_set1_epi32(INT32_MIN);
+    __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(a, bias),
+                                 _mm_xor_si128(b, bias));
+
+    return genc_sse2_select(gt, a, b);
+}
+
+static inline __m128i
+genc_sse2_vmax_u32(__m128i a, __m128i b)
+{
+    __m128i bias = _mm_set1_epi32(INT32_MIN);
+    __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(b, bias),
+                                 _mm_xor_si128(a, bias));
+
+    return genc_sse2_select(gt, a, b);
+}
+
+static inline __m128i
+genc_sse2_acc_zero_u32(void) { return _mm_setzero_si128(); }
+
+static inline __m128i
+genc_sse2_acc_add_u32(__m128i acc, uint32_t const* p)
+{
+    __m128i val = GENC_SSE2_LOADI(p);
+    __m128i zero = _mm_setzero_si128();
+
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(val, zero));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(val, zero));
+}
+
+static inline uint64_t
+genc_sse2_acc_reduce_u32(__m128i acc) { return genc_sse2_reduce_u64(acc); }
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD - SSE2 - 64-BIT INTEGERS */
+/* -------------------------------------------------------------------------- */
+
+static inline __m128i
+genc_sse2_load_i64(int64_t const* p) { return GENC_SSE2_LOADI(p); }
+
+static inline void
+genc_sse2_store_i64(int64_t* p, __m128i v) { GENC_SSE2_STOREI(p, v); }
+
+static inline __m128i
+genc_sse2_set1_i64(int64_t val) { return _mm_set1_epi64x(val); }
+
+static inline unsigned
+genc_sse2_eqmask_i64(int64_t const* p, __m128i needle)
+{
+    __m128i eq = _mm_cmpeq_epi32(GENC_SSE2_LOADI(p), needle);
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return (unsigned)_mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+static inline __m128i
+genc_sse2_vmin_i64(__m128i a, __m128i b)
+{
+    return genc_sse2_select(genc_sse2_cmpgt_i64(a, b), a, b);
+}
+
+static inline __m128i
+genc_sse2_vmax_i64(__m128i a, __m128i b)
+{
+    return genc_sse2_select(genc_sse2_cmpgt_i64(b, a), a, b);
+}
+
+static inline __m128i
+genc_sse2_acc_zero_i64(void) { return _mm_setzero_si128(); }
+
+static inline __m128i
+genc_sse2_acc_add_i64(__m128i acc, int64_t const* p)
+{
+    return _mm_add_epi64(acc, GENC_SSE2_LOADI(p));
+}
+
+static inline uint64_t
+genc_sse2_acc_reduce_i64(__m128i acc) { return genc_sse2_reduce_u64(acc); }
+
+static inline __m128i
+genc_sse2_load_u64(uint64_t const* p) { return GENC_SSE2_LOADI(p); }
+
+static inline void
+genc_sse2_store_u64(uint64_t* p, __m128i v) { GENC_SSE2_STOREI(p, v); }
+
+static inline __m128i
+genc_sse2_set1_u64(uint64_t val) { return _mm_set1_epi64x((int64_t)val); }
+
+static inline unsigned
+genc_sse2_eqmask_u64(uint64_t const* p, __m128i needle)
+{
+    return genc_sse2_eqmask_i64((int64_t const*)(void const*)p, needle);
+}
+
+static inline __m128i
+genc_sse2_vmin_u64(__m128i a, __m128i b)
+{
+    __m128i bias = _mm_set1_epi64x(INT64_MIN);
+    __m128i gt = genc_sse2_cmpgt_i64(_mm_xor_si128(a, bias),
+                                     _mm_xor_si128(b, bias));
+
+    return genc_sse2_select(gt, a, b);
+}
+
+static inline __m128i
+genc_sse2_vmax_u64(__m128i a, __m128i b)
+{
+    __m128i bias = _mm_set1_epi64x(INT64_MIN);
+    __m128i gt = genc_sse2_cmpgt_i64(_mm_xor_si128(b, bias),
+                                     _mm_xor_si128(a, bias));
+
+    return genc_sse2_select(gt, a, b);
+}
+
+static inline __m128i
+genc_sse2_acc_zero_u64(void) { return _mm_setzero_si128(); }
+
+static inline __m128i
+genc_sse2_acc_add_u64(__m128i acc, uint64_t const* p)
+{
+    return _mm_add_epi64(acc, GENC_SSE2_LOADI(p));
+}
+
+static inline uint64_t
+genc_sse2_acc_reduce_u64(__m128i acc) { return genc_sse2_reduce_u64(acc); }
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD - SSE2 - FLOATING POINT */
+/* -------------------------------------------------------------------------- */
+
+static inline __m128
+genc_sse2_load_f32(float const* p) { return _mm_loadu_ps(p); }
+
+static inline void
+genc_sse2_store_f32(float* p, __m128 v) { _mm_storeu_ps(p, v); }
+
+static inline __m128
+genc_sse2_set1_f32(float val) { return _mm_set1_ps(val); }
+
+static inline unsigned
+genc_sse2_eqmask_f32(float const* p, __m128 needle)
+{
+    return (unsigned)_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), needle));
+}
+
+static inline __m128
+genc_sse2_vmin_f32(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
+
+static inline __m128
+genc_sse2_vmax_f32(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+
+static inline __m128d
+genc_sse2_acc_zero_f32(void) { return _mm_setzero_pd(); }
+
+static inline __m128d
+genc_sse2_acc_add_f32(__m128d acc, float const* p)
+{
+    __m128 val = _mm_loadu_ps(p);
+
+    acc = _mm_add_pd(acc, _mm_cvtps_pd(val));
+    return _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(val, val)));
+}
+
+static inline double
+genc_sse2_acc_reduce_f32(__m128d acc) { return genc_sse2_reduce_f64(acc); }
+
+static inline __m128d
+genc_sse2_load_f64(double const* p) { return _mm_loadu_pd(p); }
+
+static inline void
+genc_sse2_store_f64(double* p, __m128d v) { _mm_storeu_pd(p, v); }
+
+static inline __m128d
+genc_sse2_set1_f64(double val) { return _mm_set1_pd(val); }
+
+static inline unsigned
+genc_sse2_eqmask_f64(double const* p, __m128d needle)
+{
+    return (unsigned)_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p), needle));
+}
+
+static inline __m128d
+genc_sse2_vmin_f64(__m128d a, __m128d b) { return _mm_min_pd(a, b); }
+
+static inline __m128d
+genc_sse2_vmax_f64(__m128d a, __m128d b) { return _mm_max_pd(a, b); }
+
+static inline __m128d
+genc_sse2_acc_zero_f64(void) { return _mm_setzero_pd(); }
+
+static inline __m128d
+genc_sse2_acc_add_f64(__m128d acc, double const* p)
+{
+    return _mm_add_pd(acc, _mm_loadu_pd(p));
+}
+
+static inline double
+genc_sse2_acc_reduce_f64(__m128d acc) { return genc_sse2_reduce_f64(acc); }
+
+GENC_SIMD_VECTOR_KERNELS(sse2, i32, , __m128i, __m128i, 4)
+GENC_SIMD_VECTOR_KERNELS(sse2, u32, , __m128i, __m128i, 4)
+GENC_SIMD_VECTOR_KERNELS(sse2, i64, , __m128i, __m128i, 2)
+GENC_SIMD_VECTOR_KERNELS(sse2, u64, , __m128i, __m128i, 2)
+GENC_SIMD_VECTOR_KERNELS(sse2, f32, , __m128, __m128d, 4)
+GENC_SIMD_VECTOR_KERNELS(sse2, f64, , __m128d, __m128d, 2)
+
+#endif // GENC_HAS_SSE2
+
+/* ========================================================================== */
+/* VECTOR SIMD - AVX2 KERNELS */
+/* ========================================================================== */
+
+#ifdef GENC_HAS_AVX2_DISPATCH
+
+#define GENC_AVX2 __attribute__((target("avx2")))
+
+#define GENC_AVX2_LOADI(P)                                                     \
+    _mm256_loadu_si256((__m256i const*)(void const*)(P))
+#define GENC_AVX2_STOREI(P, V)                                                 \
+    _mm256_storeu_si256((__m256i*)(void*)(P), (V))
+
+GENC_AVX2 static inline uint64_t
+genc_avx2_reduce_u64(__m256i acc)
+{
+    uint64_t lanes[4];
+    GENC_AVX2_STOREI(lanes, acc);
+
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+GENC_AVX2 static inline double
+genc_avx2_reduce_f64(__m256d acc)
+{
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD - AVX2 - 32-BIT INTEGERS */
+/* -------------------------------------------------------------------------- */
+
+GENC_AVX2 static inline __m256i
+genc_avx2_load_i32(int32_t const* p) { return GENC_AVX2_LOADI(p); }
+
+GENC_AVX2 static inline void
+genc_avx2_store_i32(int32_t* p, __m256i v) { GENC_AVX2_STOREI(p, v); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_set1_i32(int32_t val) { return _mm256_set1_epi32(val); }
+
+GENC_AVX2 static inline unsigned
+genc_avx2_eqmask_i32(int32_t const* p, __m256i needle)
+{
+    __m256i eq = _mm256_cmpeq_epi32(GENC_AVX2_LOADI(p), needle);
+
+    return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmin_i32(__m256i a, __m256i b) { return _mm256_min_epi32(a, b); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmax_i32(__m256i a, __m256i b) { return _mm256_max_epi32(a, b); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_zero_i32(void) { return _mm256_setzero_si256(); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_add_i32(__m256i acc, int32_t const* p)
+{
+    __m256i val = GENC_AVX2_LOADI(p);
+    __m256i lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(val));
+    __m256i hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(val, 1));
+
+    return _mm256_add_epi64(acc, _mm256_add_epi64(lo, hi));
+}
+
+GENC_AVX2 static inline uint64_t
+genc_avx2_acc_reduce_i32(__m256i acc) { return genc_avx2_reduce_u64(acc); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_load_u32(uint32_t const* p) { return GENC_AVX2_LOADI(p); }
+
+GENC_AVX2 static inline void
+genc_avx2_store_u32(uint32_t* p, __m256i v) { GENC_AVX2_STOREI(p, v); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_set1_u32(uint32_t val) { return _mm256_set1_epi32((int32_t)val); }
+
+GENC_AVX2 static inline unsigned
+genc_avx2_eqmask_u32(uint32_t const* p, __m256i needle)
+{
+    return genc_avx2_eqmask_i32((int32_t const*)(void const*)p, needle);
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmin_u32(__m256i a, __m256i b) { return _mm256_min_epu32(a, b); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmax_u32(__m256i a, __m256i b) { return _mm256_max_epu32(a, b); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_zero_u32(void) { return _mm256_setzero_si256(); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_add_u32(__m256i acc, uint32_t const* p)
+{
+    __m256i val = GENC_AVX2_LOADI(p);
+    __m256i lo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(val));
+    __m256i hi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(val, 1));
+
+    return _mm256_add_epi64(acc, _mm256_add_epi64(lo, hi));
+}
+
+GENC_AVX2 static inline uint64_t
+genc_avx2_acc_reduce_u32(__m256i acc) { return genc_avx2_reduce_u64(acc); }
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD - AVX2 - 64-BIT INTEGERS */
+/* -------------------------------------------------------------------------- */
+
+GENC_AVX2 static inline __m256i
+genc_avx2_load_i64(int64_t const* p) { return GENC_AVX2_LOADI(p); }
+
+GENC_AVX2 static inline void
+genc_avx2_store_i64(int64_t* p, __m256i v) { GENC_AVX2_STOREI(p, v); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_set1_i64(int64_t val) { return _mm256_set1_epi64x(val); }
+
+GENC_AVX2 static inline unsigned
+genc_avx2_eqmask_i64(int64_t const* p, __m256i needle)
+{
+    __m256i eq = _mm256_cmpeq_epi64(GENC_AVX2_LOADI(p), needle);
+
+    return (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(eq));
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmin_i64(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmax_i64(__m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a));
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_zero_i64(void) { return _mm256_setzero_si256(); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_add_i64(__m256i acc, int64_t const* p)
+{
+    return _mm256_add_epi64(acc, GENC_AVX2_LOADI(p));
+}
+
+GENC_AVX2 static inline uint64_t
+genc_avx2_acc_reduce_i64(__m256i acc) { return genc_avx2_reduce_u64(acc); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_load_u64(uint64_t const* p) { return GENC_AVX2_LOADI(p); }
+
+GENC_AVX2 static inline void
+genc_avx2_store_u64(uint64_t* p, __m256i v) { GENC_AVX2_STOREI(p, v); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_set1_u64(uint64_t val) { return _mm256_set1_epi64x((int64_t)val); }
+
+GENC_AVX2 static inline unsigned
+genc_avx2_eqmask_u64(uint64_t const* p, __m256i needle)
+{
+    return genc_avx2_eqmask_i64((int64_t const*)(void const*)p, needle);
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmin_u64(__m256i a, __m256i b)
+{
+    __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias),
+                                    _mm256_xor_si256(b, bias));
+
+    return _mm256_blendv_epi8(a, b, gt);
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_vmax_u64(__m256i a, __m256i b)
+{
+    __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    __m256i gt = _mm256_cmpgt_epi64(_mm256_xor_si256(b, bias),
+                                    _mm256_xor_si256(a, bias));
+
+    return _mm256_blendv_epi8(a, b, gt);
+}
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_zero_u64(void) { return _mm256_setzero_si256(); }
+
+GENC_AVX2 static inline __m256i
+genc_avx2_acc_add_u64(__m256i acc, uint64_t const* p)
+{
+    return _mm256_add_epi64(acc, GENC_AVX2_LOADI(p));
+}
+
+GENC_AVX2 static inline uint64_t
+genc_avx2_acc_reduce_u64(__m256i acc) { return genc_avx2_reduce_u64(acc); }
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD - AVX2 - FLOATING POINT */
+/* -------------------------------------------------------------------------- */
+
+GENC_AVX2 static inline __m256
+genc_avx2_load_f32(float const* p) { return _mm256_loadu_ps(p); }
+
+GENC_AVX2 static inline void
+genc_avx2_store_f32(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+
+GENC_AVX2 static inline __m256
+genc_avx2_set1_f32(float val) { return _mm256_set1_ps(val); }
+
+GENC_AVX2 static inline unsigned
+genc_avx2_eqmask_f32(float const* p, __m256 needle)
+{
+    __m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(p), needle, _CMP_EQ_OQ);
+
+    return (unsigned)_mm256_movemask_ps(eq);
+}
+
+GENC_AVX2 static inline __m256
+genc_avx2_vmin_f32(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+
+GENC_AVX2 static inline __m256
+genc_avx2_vmax_f32(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+
+GENC_AVX2 static inline __m256d
+genc_avx2_acc_zero_f32(void) { return _mm256_setzero_pd(); }
+
+GENC_AVX2 static inline __m256d
+genc_avx2_acc_add_f32(__m256d acc, float const* p)
+{
+    __m256 val = _mm256_loadu_ps(p);
+    __m256d lo = _mm256_cvtps_pd(_mm256_castps256_ps128(val));
+    __m256d hi = _mm256_cvtps_pd(_mm256_extractf128_ps(val, 1));
+
+    return _mm256_add_pd(acc, _mm256_add_pd(lo, hi));
+}
+
+GENC_AVX2 static inline double
+genc_avx2_acc_reduce_f32(__m256d acc) { return genc_avx2_reduce_f64(acc); }
+
+GENC_AVX2 static inline __m256d
+genc_avx2_load_f64(double const* p) { return _mm256_loadu_pd(p); }
+
+GENC_AVX2 static inline void
+genc_avx2_store_f64(double* p, __m256d v) { _mm256_storeu_pd(p, v); }
+
+GENC_AVX2 static inline __m256d
+genc_avx2_set1_f64(double val) { return _mm256_set1_pd(val); }
+
+GENC_AVX2 static inline unsigned
+genc_avx2_eqmask_f64(double const* p, __m256d needle)
+{
+    __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(p), needle, _CMP_EQ_OQ);
+
+    return (unsigned)_mm256_movemask_pd(eq);
+}
+
+GENC_AVX2 static inline __m256d
+genc_avx2_vmin_f64(__m256d a, __m256d b) { return _mm256_min_pd(a, b); }
+
+GENC_AVX2 static inline __m256d
+genc_avx2_vmax_f64(__m256d a, __m256d b) { return _mm256_max_pd(a, b); }
+
+GENC_AVX2 static inline __m256d
+genc_avx2_acc_zero_f64(void) { return _mm256_setzero_pd(); }
+
+GENC_AVX2 static inline __m256d
+genc_avx2_acc_add_f64(__m256d acc, double const* p)
+{
+    return _mm256_add_pd(acc, _mm256_loadu_pd(p));
+}
+
+GENC_AVX2 static inline double
+genc_avx2_acc_reduce_f64(__m256d acc) { return genc_avx2_reduce_f64(acc); }
+
+GENC_SIMD_VECTOR_KERNELS(avx2, i32, GENC_AVX2, __m256i, __m256i, 8)
+GENC_SIMD_VECTOR_KERNELS(avx2, u32, GENC_AVX2, __m256i, __m256i, 8)
+GENC_SIMD_VECTOR_KERNELS(avx2, i64, GENC_AVX2, __m256i, __m256i, 4)
+GENC_SIMD_VECTOR_KERNELS(avx2, u64, GENC_AVX2, __m256i, __m256i, 4)
+GENC_SIMD_VECTOR_KERNELS(avx2, f32, GENC_AVX2, __m256, __m256d, 8)
+GENC_SIMD_VECTOR_KERNELS(avx2, f64, GENC_AVX2, __m256d, __m256d, 4)
+
+#endif // GENC_HAS_AVX2_DISPATCH
+
+/* ========================================================================== */
+/* VECTOR SIMD - DISPATCH */
+/* ========================================================================== */
+
+#if defined(GENC_HAS_SSE2)
+#define GENC_SIMD_BASE(OP, KIND) genc_sse2_##OP##_##KIND
+#else
+#define GENC_SIMD_BASE(OP, KIND) genc_scalar_##OP##_##KIND
+#endif
+
+#if defined(GENC_HAS_AVX2_DISPATCH)
+#define GENC_SIMD_WIDE(OP, KIND) genc_avx2_##OP##_##KIND
+#else
+#define GENC_SIMD_WIDE(OP, KIND) GENC_SIMD_BASE(OP, KIND)
+#endif
+
+static inline bool
+genc_simd_has_avx2(void)
+{
+#if defined(__AVX2__)
+    return true;
+#elif defined(GENC_HAS_AVX2_DISPATCH)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+GENC_SIMD_DISPATCH(i32)
+GENC_SIMD_DISPATCH(u32)
+GENC_SIMD_DISPATCH(i64)
+GENC_SIMD_DISPATCH(u64)
+GENC_SIMD_DISPATCH(f32)
+GENC_SIMD_DISPATCH(f64)
+
+/* ========================================================================== */
+/* VECTOR SIMD - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR SIMD - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_VECTOR_SIMD_DEFINE(NAME, TYPE, KIND)                              \
+                                                                               \
+typedef char NAME##__simd_check                                                \
+    [(sizeof(TYPE) == sizeof(genc_simd_##KIND##_t)) ? 1 : -1];                 \
+                                                                               \
+static inline size_t                                                           \
+NAME##_find(struct NAME * v, TYPE val)                                         \
+{                                                                              \
+    if(!v) return SIZE_MAX;                                                    \
+                                                                               \
+    return genc_simd_find_##KIND(                                              \
+        (genc_simd_##KIND##_t const*)(void const*)v->data, v->size,            \
+        (genc_simd_##KIND##_t)val);                                            \
+}                                                                              \
+                                                                               \
+static inline size_t                                                           \
+NAME##_count(struct NAME * v, TYPE val)                                        \
+{                                                                              \
+    if(!v) return 0;                                                           \
+                                                                               \
+    return genc_simd_count_##KIND(                                             \
+        (genc_simd_##KIND##_t const*)(void const*)v->data, v->size,            \
+        (genc_simd_##KIND##_t)val);                                            \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_fill(struct NAME * v, TYPE val)                                         \
+{                                                                              \
+    if(!v) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    genc_simd_fill_##KIND((genc_simd_##KIND##_t*)(void*)v->data, v->size,      \
+                          (genc_simd_##KIND##_t)val);                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_min(struct NAME * v, TYPE * out)                                        \
+{                                                                              \
+    if(!v || !out) return GENC_ERR_INV_ARG;                                    \
+    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    *out = (TYPE)genc_simd_min_##KIND(                                         \
+        (genc_simd_##KIND##_t const*)(void const*)v->data, v->size);           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_max(struct NAME * v, TYPE * out)                                        \
+{                                                                              \
+    if(!v || !out) return GENC_ERR_INV_ARG;                                    \
+    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    *out = (TYPE)genc_simd_max_##KIND(                                         \
+        (genc_simd_##KIND##_t const*)(void const*)v->data, v->size);           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_sum(struct NAME * v, genc_simd_##KIND##_sum_t* out)                     \
+{                                                                              \
+    if(!v || !out) return GENC_ERR_INV_ARG;                                    \
+                                                                               \
+    *out = (genc_simd_##KIND##_sum_t)genc_simd_sum_##KIND(                     \
+        (genc_simd_##KIND##_t const*)(void const*)v->data, v->size);           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* VECTOR FILE */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* Binary snapshots for vectors generated by GENC_VECTOR or GENC_SVEC.
+ * Available on POSIX systems (GENC_HAS_POSIX_IO).
+ *
+ * GENC_VECTOR_FILE_DEFINE(NAME, TYPE) generates `static inline` functions that
+ * write a vector to a file descriptor and map such a file back as a read-only
+ * view. A mapped view reads the elements straight from the page cache, so no
+ * data is copied when the file is loaded. <name>_materialize() copies a view
+ * into an ordinary vector when it has to be modified.
+ *
+ * A file consists of a struct genc_vec_file_header followed by the elements,
+ * starting at the first multiple of GENC_VECTOR_FILE_ALIGN. Files use the
+ * byte order and type layout of the machine that wrote them, so TYPE must not
+ * contain pointers and the file must be read by a compatible build. */
+
+#define GENC_VECTOR_FILE_MAGIC 0x434E4547u // "GENC" in little-endian
+#define GENC_VECTOR_FILE_VERSION 1
+
+/* Alignment of the element data in the file. Must be a power of two no
+ * larger than the page size. */
+#ifndef GENC_VECTOR_FILE_ALIGN
+#define GENC_VECTOR_FILE_ALIGN 64
+#endif // GENC_VECTOR_FILE_ALIGN
+
+#ifdef GENC_HAS_POSIX_IO
+
+/* ========================================================================== */
+/* VECTOR FILE - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct genc_vec_file_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint64_t elem_size;
+    uint64_t count;
+    uint64_t align;
+    uint64_t data_offset;
+};
+
+struct <name>_view
+{
+    <type> const* data;
+    size_t size;
+    void* map;
+    size_t map_size;
+};
+
+|----------------------------------------------------------|
+
+* Writes the vector to `fd`, starting at the current file offset.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `vec` is NULL or `fd` is negative.
+* GENC_ERR_IO: A write failed. `errno` is set by write(), or to EIO if a
+* call wrote nothing.
+
+int <name>_save_fd(struct <name> const* vec, int fd);
+
+|----------------------------------------------------------|
+
+* Maps the file at `path` and validates its header. On success, `view->data`
+* and `view->size` describe the elements. The mapping is private and
+* read-only; it stays valid until <name>_unmap() is called.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `view` or `path` is NULL.
+* GENC_ERR_IO: The file could not be opened, inspected or mapped.
+* GENC_ERR_BAD_FORMAT: The file is not a vector snapshot of TYPE, or is
+* truncated.
+
+int <name>_map_file(struct <name>_view* view, char const* path);
+
+|----------------------------------------------------------|
+
+* Unmaps a view returned by <name>_map_file() and resets it.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `view` is NULL.
+
+int <name>_unmap(struct <name>_view* view);
+
+|----------------------------------------------------------|
+
+* Replaces the contents of `vec` with a copy of the elements of `view`. `vec`
+* must be initialized; its capacity is reused.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `view` or `vec` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_materialize(struct <name>_view const* view, struct <name>* vec);
+
+|-------------------------------------------------------- */
+
+struct genc_vec_file_header
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint64_t elem_size;
+    uint64_t count;
+    uint64_t align;
+    uint64_t data_offset;
+};
+
+static inline int
+genc_vec_file_write(int fd, void const* buf, size_t size)
+{
+    char const* it = buf;
+    while(size > 0)
+    {
+        ssize_t written = write(fd, it, size);
+        if((written < 0) && (errno == EINTR)) continue;
+
+        if(written <= 0)
+        {
+            if(written == 0) errno = EIO;
+            return GENC_ERR_IO;
+        }
+
+        it += written;
+        size -= (size_t)written;
+    }
+
+    return 0;
+}
+
+static inline int
+genc_vec_file_save(int fd, void const* data, size_t elem_size, size_t count)
+{
+    struct genc_vec_file_header header;
+    memset(&header, 0, sizeof(header));
+
+    size_t data_offset = (sizeof(header) + GENC_VECTOR_FILE_ALIGN - 1) &
+                         ~(size_t)(GENC_VECTOR_FILE_ALIGN - 1);
+
+    header.magic = GENC_VECTOR_FILE_MAGIC;
+    header.version = GENC_VECTOR_FILE_VERSION;
+    header.header_size = (uint16_t)sizeof(header);
+    header.elem_size = elem_size;
+    header.count = count;
+    header.align = GENC_VECTOR_FILE_ALIGN;
+    header.data_offset = data_offset;
+
+    int status = genc_vec_file_write(fd, &header, sizeof(header));
+    if(status != 0) return status;
+
+    static char const padding[64];
+    size_t pad = data_offset - sizeof(header);
+    while(pad > 0)
+    {
+        size_t chunk = (pad < sizeof(padding)) ? pad : sizeof(padding);
+        status = genc_vec_file_write(fd, padding, chunk);
+        if(status != 0) return status;
+        pad -= chunk;
+    }
+
+    if(count == 0) return 0;
+
+    return genc_vec_file_write(fd, data, count * elem_size);
+}
+
+/* Maps `path` and validates it as a snapshot of `elem_size` byte elements. */
+static inline int
+genc_vec_file_map(char const* path, size_t elem_size, void const** data,
+                  size_t* count, void** map, size_t* map_size)
+{
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return GENC_ERR_IO;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return GENC_ERR_IO;
+    }
+
+    if((st.st_size < (off_t)sizeof(struct genc_vec_file_header)) ||
+       ((uint64_t)st.st_size > SIZE_MAX))
+    {
+        close(fd);
+        return GENC_ERR_BAD_FORMAT;
+    }
+
+    size_t file_size = (size_t)st.st_size;
+    void* base = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(base == MAP_FAILED) return GENC_ERR_IO;
+
+    struct genc_vec_file_header header;
+    memcpy(&header, base, sizeof(header));
+
+    bool valid =
+        (header.magic == GENC_VECTOR_FILE_MAGIC) &&
+        (header.version == GENC_VECTOR_FILE_VERSION) &&
+        (header.header_size == sizeof(header)) &&
+        (header.elem_size == elem_size) &&
+        (header.align != 0) && ((header.align & (header.align - 1)) == 0) &&
+        (header.data_offset >= sizeof(header)) &&
+        (header.data_offset <= file_size) &&
+        ((((uintptr_t)base + header.data_offset) % header.align) == 0) &&
+        (header.count <= (file_size - header.data_offset) / elem_size);
+
+    if(!valid)
+    {
+        munmap(base, file_size);
+        return GENC_ERR_BAD_FORMAT;
+    }
+
+    *data = (char const*)base + header.data_offset;
+    *count = (size_t)header.count;
+    *map = base;
+    *map_size = file_size;
+
+    return 0;
+}
+
+/* ========================================================================== */
+/* VECTOR FILE - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* VECTOR FILE - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_VECTOR_FILE_DEFINE(NAME, TYPE)                                    \
+                                                                               \
+struct NAME##_view                                                             \
+{                                                                              \
+    TYPE const * data;                                                         \
+    size_t size;                                                               \
+    void* map;                                                                 \
+    size_t map_size;                                                           \
+};                                                                             \
+                                                                               \
+static inline int                                                              \
+NAME##_save_fd(struct NAME const * v, int fd)                                  \
+{                                                                              \
+    if(!v || (fd < 0)) return GENC_ERR_INV_ARG;                                \
+                                                                               \
+    return genc_vec_file_save(fd, v->data, sizeof(TYPE), v->size);             \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_map_file(struct NAME##_view * view, char const* path)                   \
+{                                                                              \
+    if(!view || !path) return GENC_ERR_INV_ARG;                                \
+                                                                               \
+    void const* data;                                                          \
+    int status = genc_vec_file_map(path, sizeof(TYPE), &data, &view->size,     \
+                                   &view->map, &view->map_size);               \
+    if(status != 0) return status;                                             \
+                                                                               \
+    view->data = data;                                                         \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_unmap(struct NAME##_view * view)                                        \
+{                                                                              \
+    if(!view) return GENC_ERR_INV_ARG;                                         \
+                                                                               \
+    if(view->map) munmap(view->map, view->map_size);                           \
+                                                                               \
+    view->data = NULL;                                                         \
+    view->size = 0;                                                            \
+    view->map = NULL;                                                          \
+    view->map_size = 0;                                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##_materialize(struct NAME##_view const * view, struct NAME * v)           \
+{                                                                              \
+    if(!view || !v) return GENC_ERR_INV_ARG;                                   \
+                                                                               \
+    NAME##_empty(v);                                                           \
+                                                                               \
+    return NAME##_pushb_many(v, view->data, view->size);                       \
+}                                                                              \
+
+#endif // GENC_HAS_POSIX_IO
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* WRITER */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* struct genc_writer batches output to a file descriptor. Available on POSIX
+ * systems (GENC_HAS_POSIX_IO).
+ *
+ * Written data is recorded as a list of segments. genc_writer_write() copies
+ * the data into a byte vector owned by the writer, merging consecutive copies
+ * into one segment; genc_writer_write_ref() records a reference to the
+ * caller's memory instead, which must stay valid and unchanged until the next
+ * flush. A flush submits all segments with writev(), or with pwritev() at the
+ * writer's offset for writers created by genc_writer_init_at(). Data is
+ * flushed automatically once `threshold` bytes are pending.
+ *
+ * Flushing empties the writer's vectors without freeing them, so once they
+ * have grown to the steady-state size, writing does not allocate. */
+
+#ifndef GENC_WRITER_DEFAULT_THRESHOLD
+#define GENC_WRITER_DEFAULT_THRESHOLD (64 * 1024)
+#endif // GENC_WRITER_DEFAULT_THRESHOLD
+
+#ifdef GENC_HAS_POSIX_IO
+
+/* Maximum number of segments per writev() call. The iovecs of a call live
+ * on the stack, so the limit is capped at 1024. */
+#if defined(IOV_MAX) && (IOV_MAX < 1024)
+#define GENC_WRITER_IOV_MAX IOV_MAX
+#else
+#define GENC_WRITER_IOV_MAX 1024
+#endif // GENC_WRITER_IOV_MAX
+
+/* ========================================================================== */
+/* WRITER - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct genc_writer
+{
+    struct genc_writer_bytes bytes;
+    struct genc_writer_segs segs;
+    size_t pending;
+    size_t threshold;
+    off_t offset;
+    bool positional;
+    int fd;
+};
+
+|----------------------------------------------------------|
+
+* Initializes a writer for `fd`. No memory is allocated until the first
+* write. If `threshold` is 0, GENC_WRITER_DEFAULT_THRESHOLD is used.
+* genc_writer_init_at() creates a positional writer that writes at `offset`
+* with pwritev() and advances it, leaving the file offset of `fd` unchanged.
+* It requires GENC_HAS_PWRITEV.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `writer` is NULL, `fd` is negative, or `offset` is
+* negative.
+
+int genc_writer_init(struct genc_writer* writer, int fd, size_t threshold);
+int genc_writer_init_at(struct genc_writer* writer, int fd, off_t offset,
+                        size_t threshold);
+
+|----------------------------------------------------------|
+
+* Frees the writer's memory. Pending data is discarded; flush first to keep
+* it. The file descriptor is not closed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `writer` is NULL.
+
+int genc_writer_deinit(struct genc_writer* writer);
+
+|----------------------------------------------------------|
+
+* Appends `size` bytes from `data`. genc_writer_write() copies them;
+* genc_writer_write_ref() references them until the next flush. If this makes
+* `threshold` or more bytes pending, the writer is flushed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `writer` is NULL, or `data` is NULL when `size` is
+* nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed. Nothing was appended.
+* GENC_ERR_IO: The data was appended, but the automatic flush failed (see
+* genc_writer_flush()).
+
+int genc_writer_write(struct genc_writer* writer, void const* data,
+                      size_t size);
+int genc_writer_write_ref(struct genc_writer* writer, void const* data,
+                          size_t size);
+
+|----------------------------------------------------------|
+
+* Writes all pending data. Partial writes are continued and interrupted calls
+* are retried. Flushing does not allocate memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `writer` is NULL.
+* GENC_ERR_IO: A write failed. `errno` is set by writev()/pwritev(), or to
+* EIO if a call wrote nothing. The data that was not written stays pending.
+
+int genc_writer_flush(struct genc_writer* writer);
+
+|-------------------------------------------------------- */
+
+/* A pending segment: `len` bytes at `ext`, or at offset `off` of the byte
+ * vector if `ext` is NULL. */
+struct genc_writer_seg
+{
+    char const* ext;
+    size_t off;
+    size_t len;
+};
+
+GENC_VECTOR_INLINE(genc_writer_bytes, char, 2.0)
+GENC_VECTOR_INLINE(genc_writer_segs, struct genc_writer_seg, 2.0)
+
+struct genc_writer
+{
+    struct genc_writer_bytes bytes;
+    struct genc_writer_segs segs;
+    size_t pending;
+    size_t threshold;
+    off_t offset;
+    bool positional;
+    int fd;
+};
+
+static inline int
+genc_writer_init(struct genc_writer* writer, int fd, size_t threshold)
+{
+    if(!writer || (fd < 0)) return GENC_ERR_INV_ARG;
+
+    memset(writer, 0, sizeof(*writer));
+    writer->threshold = threshold ? threshold : GENC_WRITER_DEFAULT_THRESHOLD;
+    writer->fd = fd;
+
+    return 0;
+}
+
+#ifdef GENC_HAS_PWRITEV
+static inline int
+genc_writer_init_at(struct genc_writer* writer, int fd, off_t offset,
+                    size_t threshold)
+{
+    if(offset < 0) return GENC_ERR_INV_ARG;
+
+    int status = genc_writer_init(writer, fd, threshold);
+    if(status != 0) return status;
+
+    writer->offset = offset;
+    writer->positional = true;
+
+    return 0;
+}
+#endif // GENC_HAS_PWRITEV
+
+static inline int
+genc_writer_deinit(struct genc_writer* writer)
+{
+    if(!writer) return GENC_ERR_INV_ARG;
+
+    genc_writer_bytes_deinit(&writer->bytes);
+    genc_writer_segs_deinit(&writer->segs);
+    writer->pending = 0;
+
+    return 0;
+}
+
+static inline ssize_t
+genc_writer_submit(struct genc_writer* writer, struct iovec const* iov,
+                   int count)
+{
+#ifdef GENC_HAS_PWRITEV
+    if(writer->positional)
+        return pwritev(writer->fd, iov, count, writer->offset);
+#endif
+    return writev(writer->fd, iov, count);
+}
+
+static inline int
+genc_writer_flush(struct genc_writer* writer)
+{
+    if(!writer) return GENC_ERR_INV_ARG;
+
+    struct genc_writer_seg* segs = writer->segs.data;
+    size_t count = writer->segs.size;
+    size_t first = 0;
+
+    /* The iovecs of each call are built on the stack, so flushing does not
+     * allocate. They are resolved from the segments here because the byte
+     * vector may have moved since the segments were recorded. */
+    struct iovec iov[GENC_WRITER_IOV_MAX];
+    while(first < count)
+    {
+        size_t batch = count - first;
+        if(batch > GENC_WRITER_IOV_MAX) batch = GENC_WRITER_IOV_MAX;
+
+        size_t i;
+        for(i = 0; i < batch; i++)
+        {
+            struct genc_writer_seg const* seg = &segs[first + i];
+
+            iov[i].iov_base = (void*)(seg->ext ? seg->ext :
+                                      writer->bytes.data + seg->off);
+            iov[i].iov_len = seg->len;
+        }
+
+        ssize_t written = genc_writer_submit(writer, iov, (int)batch);
+        if((written < 0) && (errno == EINTR)) continue;
+
+        if(written <= 0)
+        {
+            if(written == 0) errno = EIO;
+
+            /* Keep the unwritten part pending. */
+            genc_writer_segs_rm_at_many(&writer->segs, 0, first);
+
+            return GENC_ERR_IO;
+        }
+
+        if(writer->positional) writer->offset += written;
+        writer->pending -= (size_t)written;
+
+        size_t left = (size_t)written;
+        while((first < count) && (left >= segs[first].len))
+        {
+            left -= segs[first].len;
+            ++first;
+        }
+        if(left > 0)
+        {
+            if(segs[first].ext)
+                segs[first].ext += left;
+            else
+                segs[first].off += left;
+            segs[first].len -= left;
+        }
+    }
+
+    genc_writer_bytes_empty(&writer->bytes);
+    genc_writer_segs_empty(&writer->segs);
+
+    return 0;
+}
+
+static inline int
+genc_writer_write(struct genc_writer* writer, void const* data, size_t size)
+{
+    if(!writer || (!data && (size > 0))) return GENC_ERR_INV_ARG;
+
+    if(size == 0) return 0;
+
+    size_t off = writer->bytes.size;
+    struct genc_writer_seg* last = (writer->segs.size > 0) ?
+        &writer->segs.data[writer->segs.size - 1] : NULL;
+
+    if(last && !last->ext && (last->off + last->len == off))
+    {
+        if(genc_writer_bytes_pushb_many(&writer->bytes, data, size) != 0)
+            return GENC_ERR_ALLOC_FAIL;
+
+        last->len += size;
+    }
+    else
+    {
+        struct genc_writer_seg seg = { NULL, off, size };
+        if(genc_writer_segs_pushb(&writer->segs, seg) != 0)
+            return GENC_ERR_ALLOC_FAIL;
+
+        if(genc_writer_bytes_pushb_many(&writer->bytes, data, size) != 0)
+        {
+            genc_writer_segs_popb(&writer->segs);
+            return GENC_ERR_ALLOC_FAIL;
+        }
+    }
+
+    writer->pending += size;
+    if(writer->pending >= writer->threshold)
+        return genc_writer_flush(writer);
+
+    return 0;
+}
+
+static inline int
+genc_writer_write_ref(struct genc_writer* writer, void const* data,
+                      size_t size)
+{
+    if(!writer || (!data && (size > 0))) return GENC_ERR_INV_ARG;
+
+    if(size == 0) return 0;
+
+    struct genc_writer_seg seg = { data, 0, size };
+    if(genc_writer_segs_pushb(&writer->segs, seg) != 0)
+        return GENC_ERR_ALLOC_FAIL;
+
+    writer->pending += size;
+    if(writer->pending >= writer->threshold)
+        return genc_writer_flush(writer);
+
+    return 0;
+}
+
+#endif // GENC_HAS_POSIX_IO
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* FLAT MAP */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_FLAT_MAP_DECLARE() and GENC_FLAT_MAP_DEFINE() generate a map stored as
+ * a GENC_VECTOR of entries kept sorted by key. GENC_FLAT_SET_DECLARE() and
+ * GENC_FLAT_SET_DEFINE() do the same for keys alone. The _INLINE() variants
+ * generate both with `static inline`.
+ *
+ * Lookups are branchless binary searches over the contiguous entries, which
+ * suits tables that are built once and probed often. Single insertions shift
+ * the tail of the vector; to fill a table, append all entries at once with
+ * <name>_build(), which sorts and deduplicates a single time.
+ *
+ * LESS_EXPR is an expression over `a` and `b`, both of type `KEY const*`,
+ * that is true if `*a` orders before `*b`. Two keys are equal if neither
+ * orders before the other.
+ *
+ * The whole GENC_VECTOR API is generated as well, along with <name>_sort()
+ * and <name>_stable_sort() from GENC_VECTOR_SORT_DEFINE(). Vector functions
+ * that remove elements keep the order; ones that insert elements (<name>_ins,
+ * <name>_pushb and their _many variants) do not, and must be followed by a
+ * call to <name>_build() with no new entries. */
+
+/* ========================================================================== */
+/* FLAT MAP - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>_entry
+{
+    <key> key;
+    <val> val; // GENC_FLAT_MAP only
+};
+
+struct <name>
+{
+    struct <name>_entry* data;
+    size_t size;
+    size_t cap;
+};
+
+|----------------------------------------------------------|
+
+* Returns the index of the first entry whose key does not order before `key`.
+
+* RETURN VALUE: Index in [0, size]; 0 if `map` is NULL.
+
+size_t <name>_lower_bound(struct <name>* map, <key> key);
+
+|----------------------------------------------------------|
+
+* Returns the index of the first entry whose key orders after `key`.
+
+* RETURN VALUE: Index in [0, size]; 0 if `map` is NULL.
+
+size_t <name>_upper_bound(struct <name>* map, <key> key);
+
+|----------------------------------------------------------|
+
+* Returns the entry with key `key`.
+
+* RETURN VALUE: Pointer to the entry, NULL if `key` is absent or `map` is
+* NULL.
+
+struct <name>_entry* <name>_find(struct <name>* map, <key> key);
+
+|----------------------------------------------------------|
+
+* Inserts an entry for `key`, keeping the order. For a map, the value of an
+* existing entry is overwritten with `val`; for a set, inserting a present
+* key has no effect.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_put(struct <name>* map, <key> key, <val> val); // GENC_FLAT_MAP
+int <name>_put(struct <name>* map, <key> key); // GENC_FLAT_SET
+
+|----------------------------------------------------------|
+
+* Removes the entry with key `key`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+* GENC_ERR_NO_DATA: `key` is absent.
+
+int <name>_rm(struct <name>* map, <key> key);
+
+|----------------------------------------------------------|
+
+* Appends `count` entries from `entries`, then sorts the table once and
+* removes duplicate keys. Of entries with equal keys, the one appended last
+* is kept, so new entries replace existing ones. If the call fails, the table
+* is left unchanged.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL, or `entries` is NULL when `count` is
+* nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_build(struct <name>* map, struct <name>_entry const* entries,
+                 size_t count);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* FLAT MAP - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* FLAT MAP - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_FLAT_MAP_DECLARE(NAME, KEY, VAL, FN_PREFIX)                       \
+                                                                               \
+struct NAME##_entry                                                            \
+{                                                                              \
+    KEY key;                                                                   \
+    VAL val;                                                                   \
+};                                                                             \
+                                                                               \
+GENC_FLAT_DECLARE_IMPL(NAME, KEY, FN_PREFIX)                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_put(struct NAME * m, KEY key, VAL val);                                 \
+
+#define GENC_FLAT_SET_DECLARE(NAME, KEY, FN_PREFIX)                            \
+                                                                               \
+struct NAME##_entry                                                            \
+{                                                                              \
+    KEY key;                                                                   \
+};                                                                             \
+                                                                               \
+GENC_FLAT_DECLARE_IMPL(NAME, KEY, FN_PREFIX)                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_put(struct NAME * m, KEY key);                                          \
+
+#define GENC_FLAT_DECLARE_IMPL(NAME, KEY, FN_PREFIX)                           \
+                                                                               \
+GENC_VECTOR_DECLARE(NAME, struct NAME##_entry, FN_PREFIX)                      \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_lower_bound(struct NAME * m, KEY key);                                  \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_upper_bound(struct NAME * m, KEY key);                                  \
+                                                                               \
+FN_PREFIX struct NAME##_entry *                                                \
+NAME##_find(struct NAME * m, KEY key);                                         \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm(struct NAME * m, KEY key);                                           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_build(struct NAME * m, struct NAME##_entry const * entries,             \
+             size_t count);                                                    \
+
+/* -------------------------------------------------------------------------- */
+/* FLAT MAP - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_FLAT_MAP_DEFINE(NAME, KEY, VAL, LESS_EXPR, GROWF, FN_PREFIX)      \
+                                                                               \
+GENC_FLAT_DEFINE_IMPL(NAME, KEY, LESS_EXPR, GROWF, FN_PREFIX)                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_put(struct NAME * m, KEY key, VAL val)                                  \
+{                                                                              \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t pos = NAME##_lower_bound(m, key);                                   \
+    if((pos < m->size) && !NAME##__key_less(&key, &m->data[pos].key))          \
+    {                                                                          \
+        m->data[pos].val = val;                                                \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    struct NAME##_entry entry;                                                 \
+    entry.key = key;                                                           \
+    entry.val = val;                                                           \
+                                                                               \
+    return NAME##_ins_many(m, &entry, 1, pos);                                 \
+}                                                                              \
+
+#define GENC_FLAT_SET_DEFINE(NAME, KEY, LESS_EXPR, GROWF, FN_PREFIX)           \
+                                                                               \
+GENC_FLAT_DEFINE_IMPL(NAME, KEY, LESS_EXPR, GROWF, FN_PREFIX)                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_put(struct NAME * m, KEY key)                                           \
+{                                                                              \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t pos = NAME##_lower_bound(m, key);                                   \
+    if((pos < m->size) && !NAME##__key_less(&key, &m->data[pos].key))          \
+        return 0;                                                              \
+                                                                               \
+    struct NAME##_entry entry;                                                 \
+    entry.key = key;                                                           \
+                                                                               \
+    return NAME##_ins_many(m, &entry, 1, pos);                                 \
+}                                                                              \
+
+#define GENC_FLAT_DEFINE_IMPL(NAME, KEY, LESS_EXPR, GROWF, FN_PREFIX)          \
+                                                                               \
+GENC_VECTOR_DEFINE(NAME, struct NAME##_entry, GROWF, FN_PREFIX)                \
+                                                                               \
+static inline bool                                                             \
+NAME##__key_less(KEY const * a, KEY const * b)                                 \
+{                                                                              \
+    return (LESS_EXPR);                                                        \
+}                                                                              \
+                                                                               \
+GENC_VECTOR_SORT_DEFINE(NAME, struct NAME##_entry,                             \
+                        NAME##__key_less(&a->key, &b->key))                    \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_lower_bound(struct NAME * m, KEY key)                                   \
+{                                                                              \
+    if(!m || (m->size == 0)) return 0;                                         \
+                                                                               \
+    struct NAME##_entry const * base = m->data;                                \
+    size_t count = m->size;                                                    \
+                                                                               \
+    while(count > 1)                                                           \
+    {                                                                          \
+        size_t half = count / 2;                                               \
+        base = NAME##__key_less(&base[half - 1].key, &key) ?                   \
+            base + half : base;                                                \
+        count -= half;                                                         \
+    }                                                                          \
+                                                                               \
+    return (size_t)(base - m->data) + NAME##__key_less(&base->key, &key);      \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_upper_bound(struct NAME * m, KEY key)                                   \
+{                                                                              \
+    if(!m || (m->size == 0)) return 0;                                         \
+                                                                               \
+    struct NAME##_entry const * base = m->data;                                \
+    size_t count = m->size;                                                    \
+                                                                               \
+    while(count > 1)                                                           \
+    {                                                                          \
+        size_t half = count / 2;                                               \
+        base = !NAME##__key_less(&key, &base[half - 1].key) ?                  \
+            base + half : base;                                                \
+        count -= half;                                                         \
+    }                                                                          \
+                                                                               \
+    return (size_t)(base - m->data) + !NAME##__key_less(&key, &base->key);     \
+}                                                                              \
+                                                                               \
+FN_PREFIX struct NAME##_entry *                                                \
+NAME##_find(struct NAME * m, KEY key)                                          \
+{                                                                              \
+    if(!m) return NULL;                                                        \
+                                                                               \
+    size_t pos = NAME##_lower_bound(m, key);                                   \
+    if((pos < m->size) && !NAME##__key_less(&key, &m->data[pos].key))          \
+        return &m->data[pos];                                                  \
+                                                                               \
+    return NULL;                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm(struct NAME * m, KEY key)                                            \
+{                                                                              \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    size_t pos = NAME##_lower_bound(m, key);                                   \
+    if((pos >= m->size) || NAME##__key_less(&key, &m->data[pos].key))          \
+        return GENC_ERR_NO_DATA;                                               \
+                                                                               \
+    return NAME##_rm_at(m, pos);                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_build(struct NAME * m, struct NAME##_entry const * entries,             \
+             size_t count)                                                     \
+{                                                                              \
+    if(!m || (!entries && (count > 0))) return GENC_ERR_INV_ARG;               \
+                                                                               \
+    if(count > SIZE_MAX - m->size) return GENC_ERR_ALLOC_FAIL;                 \
+                                                                               \
+    size_t total = m->size + count;                                            \
+    struct NAME##_entry * scratch = NULL;                                      \
+                                                                               \
+    if(total / 2 > 0)                                                          \
+    {                                                                          \
+        if(total / 2 > SIZE_MAX / sizeof(struct NAME##_entry))                 \
+            return GENC_ERR_ALLOC_FAIL;                                        \
+                                                                               \
+        scratch = malloc(total / 2 * sizeof(struct NAME##_entry));             \
+        if(!scratch) return GENC_ERR_ALLOC_FAIL;                               \
+    }                                                                          \
+                                                                               \
+    int status = NAME##_pushb_many(m, entries, count);                         \
+    if(status != 0)                                                            \
+    {                                                                          \
+        free(scratch);                                                         \
+        return status;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Stable, so the last of equal keys is the one appended last. */          \
+    NAME##_stable_sort(m, scratch);                                            \
+    free(scratch);                                                             \
+                                                                               \
+    size_t keep = 0;                                                           \
+    size_t i;                                                                  \
+    for(i = 0; i < m->size; i++)                                               \
+    {                                                                          \
+        if((keep > 0) &&                                                       \
+           !NAME##__key_less(&m->data[keep - 1].key, &m->data[i].key))         \
+            m->data[keep - 1] = m->data[i];                                    \
+        else                                                                   \
+            m->data[keep++] = m->data[i];                                      \
+    }                                                                          \
+    m->size = keep;                                                            \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* FLAT MAP - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_FLAT_MAP_INLINE(NAME, KEY, VAL, LESS_EXPR, GROWF)                 \
+    GENC_FLAT_MAP_DECLARE(NAME, KEY, VAL, static inline)                       \
+    GENC_FLAT_MAP_DEFINE(NAME, KEY, VAL, LESS_EXPR, GROWF, static inline)      \
+
+#define GENC_FLAT_SET_INLINE(NAME, KEY, LESS_EXPR, GROWF)                      \
+    GENC_FLAT_SET_DECLARE(NAME, KEY, static inline)                            \
+    GENC_FLAT_SET_DEFINE(NAME, KEY, LESS_EXPR, GROWF, static inline)           \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* HEAP */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_HEAP_DECLARE() and GENC_HEAP_DEFINE() generate a type-safe d-ary heap
+ * (priority queue) API. The heap is an implicit tree in a contiguous array
+ * with the same `data/size/cap` shape as a GENC_VECTOR. GENC_HEAP_INLINE()
+ * generates both with `static inline`.
+ *
+ * GENC_IHEAP_DECLARE(), GENC_IHEAP_DEFINE() and GENC_IHEAP_INLINE() generate
+ * an indexed heap: every pushed element gets a handle that stays valid until
+ * the element leaves the heap, and can be used to change the element's
+ * priority or remove it in O(log n). Handles of removed elements are reused
+ * by later pushes, so a handle must not be used after its element left the
+ * heap: once reissued, it refers to the new element.
+ *
+ * LESS_EXPR is an expression over `a` and `b`, both of type `TYPE const*`,
+ * that is true if `*a` orders before `*b`; the top of the heap is the
+ * element that orders first. ARITY is the number of children per node and
+ * must be at least 2. Higher arities make the tree shallower, which speeds
+ * up pushes and keeps sift-downs on fewer cache lines for large heaps, at
+ * the cost of more comparisons per level; 4 is a good default.
+ *
+ * The generated structures must be zero-initialized before their first
+ * use. */
+
+/* ========================================================================== */
+/* HEAP - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    <type>* data;
+    size_t size;
+    size_t cap;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the heap and frees allocated memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+
+int <name>_deinit(struct <name>* heap);
+
+|----------------------------------------------------------|
+
+* Pushes `data` onto the heap.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_push(struct <name>* heap, <type> data);
+
+|----------------------------------------------------------|
+
+* Removes the top element and stores it into `out`, if `out` is not NULL.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+* GENC_ERR_NO_DATA: The heap is empty.
+
+int <name>_pop(struct <name>* heap, <type>* out);
+
+|----------------------------------------------------------|
+
+* Returns a pointer to the top element. The element must not be modified in
+* a way that changes its order.
+
+* RETURN VALUE: Pointer to the top element, NULL if the heap is empty or
+* `heap` is NULL.
+
+<type>* <name>_peek(struct <name>* heap);
+
+|----------------------------------------------------------|
+
+* Adds `count` elements from `data` and restores the heap order with a
+* bottom-up rebuild in O(size + count).
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL, or `data` is NULL when `count` is
+* nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_heapify(struct <name>* heap, <type> const* data, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes all elements while retaining allocated capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+
+int <name>_empty(struct <name>* heap);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* INDEXED HEAP - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>_node
+{
+    <type> data;
+    size_t handle;
+};
+
+struct <name>
+{
+    struct <name>_node* data;
+    size_t size;
+    size_t cap;
+    size_t* pos;
+    size_t free_head;
+    size_t next_handle;
+};
+
+|----------------------------------------------------------|
+
+* <name>_deinit() and <name>_empty() behave as for GENC_HEAP. Emptying the
+* heap invalidates all handles.
+
+|----------------------------------------------------------|
+
+* Pushes `data` onto the heap and stores its handle into `handle`, if
+* `handle` is not NULL.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_push(struct <name>* heap, <type> data, size_t* handle);
+
+|----------------------------------------------------------|
+
+* Removes the top element and stores it into `out`, if `out` is not NULL.
+* Its handle becomes invalid.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+* GENC_ERR_NO_DATA: The heap is empty.
+
+int <name>_pop(struct <name>* heap, <type>* out);
+
+|----------------------------------------------------------|
+
+* Returns a pointer to the top node, which holds the element and its handle.
+
+* RETURN VALUE: Pointer to the top node, NULL if the heap is empty or `heap`
+* is NULL.
+
+struct <name>_node* <name>_peek(struct <name>* heap);
+
+|----------------------------------------------------------|
+
+* Returns a pointer to the element with handle `handle`. The element must not
+* be modified in a way that changes its order; use <name>_update() instead.
+
+* RETURN VALUE: Pointer to the element, NULL if `handle` is not currently
+* issued or `heap` is NULL.
+
+<type>* <name>_get(struct <name>* heap, size_t handle);
+
+|----------------------------------------------------------|
+
+* Replaces the element with handle `handle` by `data`, which must not order
+* after the current element, and moves it towards the top.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL, or `data` orders after the current
+* element.
+* GENC_ERR_NO_DATA: `handle` is not currently issued.
+
+int <name>_decrease_key(struct <name>* heap, size_t handle, <type> data);
+
+|----------------------------------------------------------|
+
+* Replaces the element with handle `handle` by `data` and restores the heap
+* order in either direction.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+* GENC_ERR_NO_DATA: `handle` is not currently issued.
+
+int <name>_update(struct <name>* heap, size_t handle, <type> data);
+
+|----------------------------------------------------------|
+
+* Removes the element with handle `handle` and stores it into `out`, if
+* `out` is not NULL.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL.
+* GENC_ERR_NO_DATA: `handle` is not currently issued.
+
+int <name>_erase(struct <name>* heap, size_t handle, <type>* out);
+
+|----------------------------------------------------------|
+
+* Adds `count` elements from `data` in O(size + count), like
+* <name>_heapify() of GENC_HEAP. If `handles` is not NULL, the handle of
+* `data[i]` is stored into `handles[i]`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `heap` is NULL, or `data` is NULL when `count` is
+* nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_heapify(struct <name>* heap, <type> const* data, size_t count,
+                   size_t* handles);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* HEAP - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* HEAP - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HEAP_DECLARE(NAME, TYPE, FN_PREFIX)                               \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    TYPE * data;                                                               \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * h);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_push(struct NAME * h, TYPE data);                                       \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pop(struct NAME * h, TYPE * out);                                       \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_peek(struct NAME * h);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_heapify(struct NAME * h, TYPE const * data, size_t count);              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * h);                                                 \
+
+/* -------------------------------------------------------------------------- */
+/* HEAP - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HEAP_DEFINE(NAME, TYPE, LESS_EXPR, ARITY, FN_PREFIX)              \
+                                                                               \
+typedef char NAME##__arity_check[((ARITY) >= 2) ? 1 : -1];                     \
+                                                                               \
+static inline bool                                                             \
+NAME##__less(TYPE const * a, TYPE const * b)                                   \
+{                                                                              \
+    return (LESS_EXPR);                                                        \
+}                                                                              \
+                                                                               \
+/* Makes room for `count` more elements, at least doubling the capacity. */    \
+static inline int                                                              \
+NAME##__reserve(struct NAME * h, size_t count)                                 \
+{                                                                              \
+    if(count > SIZE_MAX - h->size) return GENC_ERR_ALLOC_FAIL;                 \
+    if(h->size + count <= h->cap) return 0;                                    \
+                                                                               \
+    size_t new_cap = (h->cap > 0) ? h->cap : 8;                                \
+    while(new_cap < h->size + count)                                           \
+    {                                                                          \
+        if(new_cap > SIZE_MAX / 2) return GENC_ERR_ALLOC_FAIL;                 \
+        new_cap *= 2;                                                          \
+    }                                                                          \
+    if(new_cap > SIZE_MAX / sizeof(TYPE)) return GENC_ERR_ALLOC_FAIL;          \
+                                                                               \
+    TYPE * new_data = realloc(h->data, new_cap * sizeof(TYPE));                \
+    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+                                                                               \
+    h->data = new_data;                                                        \
+    h->cap = new_cap;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__sift_up(struct NAME * h, size_t pos)                                   \
+{                                                                              \
+    TYPE tmp = h->data[pos];                                                   \
+                                                                               \
+    while(pos > 0)                                                             \
+    {                                                                          \
+        size_t parent = (pos - 1) / (ARITY);                                   \
+        if(!NAME##__less(&tmp, &h->data[parent])) break;                       \
+                                                                               \
+        h->data[pos] = h->data[parent];                                        \
+        pos = parent;                                                          \
+    }                                                                          \
+                                                                               \
+    h->data[pos] = tmp;                                                        \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__sift_down(struct NAME * h, size_t pos)                                 \
+{                                                                              \
+    TYPE tmp = h->data[pos];                                                   \
+                                                                               \
+    for(;;)                                                                    \
+    {                                                                          \
+        if(pos > (h->size - 1) / (ARITY)) break;                               \
+                                                                               \
+        size_t first = pos * (ARITY) + 1;                                      \
+        if(first >= h->size) break;                                            \
+                                                                               \
+        size_t end = ((h->size - first) > (ARITY)) ?                           \
+            first + (ARITY) : h->size;                                         \
+                                                                               \
+        size_t best = first;                                                   \
+        size_t i;                                                              \
+        for(i = first + 1; i < end; i++)                                       \
+        {                                                                      \
+            if(NAME##__less(&h->data[i], &h->data[best]))                      \
+                best = i;                                                      \
+        }                                                                      \
+                                                                               \
+        if(!NAME##__less(&h->data[best], &tmp)) break;                         \
+                                                                               \
+        h->data[pos] = h->data[best];                                          \
+        pos = best;                                                            \
+    }                                                                          \
+                                                                               \
+    h->data[pos] = tmp;                                                        \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * h)                                                 \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    free(h->data);                                                             \
+    h->data = NULL;                                                            \
+    h->size = 0;                                                               \
+    h->cap = 0;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_push(struct NAME * h, TYPE data)                                        \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    int status = NAME##__reserve(h, 1);                                        \
+    if(status != 0) return status;                                             \
+                                                                               \
+    h->data[h->size] = data;                                                   \
+    ++(h->size);                                                               \
+    NAME##__sift_up(h, h->size - 1);                                           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pop(struct NAME * h, TYPE * out)                                        \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+    if(h->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    if(out) *out = h->data[0];                                                 \
+                                                                               \
+    --(h->size);                                                               \
+    if(h->size > 0)                                                            \
+    {                                                                          \
+        h->data[0] = h->data[h->size];                                         \
+        NAME##__sift_down(h, 0);                                               \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_peek(struct NAME * h)                                                   \
+{                                                                              \
+    if(!h || (h->size == 0)) return NULL;                                      \
+                                                                               \
+    return &h->data[0];                                                        \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_heapify(struct NAME * h, TYPE const * data, size_t count)               \
+{                                                                              \
+    if(!h || (!data && (count > 0))) return GENC_ERR_INV_ARG;                  \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    int status = NAME##__reserve(h, count);                                    \
+    if(status != 0) return status;                                             \
+                                                                               \
+    memcpy(h->data + h->size, data, count * sizeof(TYPE));                     \
+    h->size += count;                                                          \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = (h->size - 1) / (ARITY) + 1; i > 0; i--)                           \
+        NAME##__sift_down(h, i - 1);                                           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * h)                                                  \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    h->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* HEAP - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HEAP_INLINE(NAME, TYPE, LESS_EXPR, ARITY)                         \
+    GENC_HEAP_DECLARE(NAME, TYPE, static inline)                               \
+    GENC_HEAP_DEFINE(NAME, TYPE, LESS_EXPR, ARITY, static inline)              \
+
+/* -------------------------------------------------------------------------- */
+/* INDEXED HEAP - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_IHEAP_DECLARE(NAME, TYPE, FN_PREFIX)                              \
+                                                                               \
+struct NAME##_node                                                             \
+{                                                                              \
+    TYPE data;                                                                 \
+    size_t handle;                                                             \
+};                                                                             \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct NAME##_node * data;                                                 \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+    size_t* pos;                                                               \
+    size_t free_head;                                                          \
+    size_t next_handle;                                                        \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * h);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_push(struct NAME * h, TYPE data, size_t* handle);                       \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pop(struct NAME * h, TYPE * out);                                       \
+                                                                               \
+FN_PREFIX struct NAME##_node *                                                 \
+NAME##_peek(struct NAME * h);                                                  \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_get(struct NAME * h, size_t handle);                                    \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_decrease_key(struct NAME * h, size_t handle, TYPE data);                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_update(struct NAME * h, size_t handle, TYPE data);                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_erase(struct NAME * h, size_t handle, TYPE * out);                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_heapify(struct NAME * h, TYPE const * data, size_t count,               \
+               size_t* handles);                                               \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * h);                                                 \
+
+/* -------------------------------------------------------------------------- */
+/* INDEXED HEAP - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+/* `pos` maps a handle to the index of its node. Handles that are not in use
+ * form a free list through `pos`; `free_head` holds the first one plus one,
+ * so that 0 means an empty list. No node refers to a free handle, so handles
+ * that are not currently issued are detected. A stale handle that has been
+ * reissued cannot be told apart from the new one. At most `cap` handles are
+ * ever issued, so `pos` has `cap` entries too. */
+#define GENC_IHEAP_DEFINE(NAME, TYPE, LESS_EXPR, ARITY, FN_PREFIX)             \
+                                                                               \
+typedef char NAME##__arity_check[((ARITY) >= 2) ? 1 : -1];                     \
+                                                                               \
+static inline bool                                                             \
+NAME##__less(TYPE const * a, TYPE const * b)                                   \
+{                                                                              \
+    return (LESS_EXPR);                                                        \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##__reserve(struct NAME * h, size_t count)                                 \
+{                                                                              \
+    if(count > SIZE_MAX - h->size) return GENC_ERR_ALLOC_FAIL;                 \
+    if(h->size + count <= h->cap) return 0;                                    \
+                                                                               \
+    size_t new_cap = (h->cap > 0) ? h->cap : 8;                                \
+    while(new_cap < h->size + count)                                           \
+    {                                                                          \
+        if(new_cap > SIZE_MAX / 2) return GENC_ERR_ALLOC_FAIL;                 \
+        new_cap *= 2;                                                          \
+    }                                                                          \
+    if(new_cap > SIZE_MAX / sizeof(struct NAME##_node))                        \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    size_t* new_pos = realloc(h->pos, new_cap * sizeof(size_t));               \
+    if(!new_pos) return GENC_ERR_ALLOC_FAIL;                                   \
+    h->pos = new_pos;                                                          \
+                                                                               \
+    struct NAME##_node * new_data =                                            \
+        realloc(h->data, new_cap * sizeof(struct NAME##_node));                \
+    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+                                                                               \
+    h->data = new_data;                                                        \
+    h->cap = new_cap;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline size_t                                                           \
+NAME##__take_handle(struct NAME * h)                                           \
+{                                                                              \
+    if(h->free_head == 0)                                                      \
+        return (h->next_handle)++;                                             \
+                                                                               \
+    size_t handle = h->free_head - 1;                                          \
+    h->free_head = h->pos[handle];                                             \
+                                                                               \
+    return handle;                                                             \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__release_handle(struct NAME * h, size_t handle)                         \
+{                                                                              \
+    h->pos[handle] = h->free_head;                                             \
+    h->free_head = handle + 1;                                                 \
+}                                                                              \
+                                                                               \
+static inline bool                                                             \
+NAME##__valid(struct NAME * h, size_t handle)                                  \
+{                                                                              \
+    return (handle < h->next_handle) && (h->pos[handle] < h->size) &&          \
+        (h->data[h->pos[handle]].handle == handle);                            \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__place(struct NAME * h, size_t pos, struct NAME##_node node)            \
+{                                                                              \
+    h->data[pos] = node;                                                       \
+    h->pos[node.handle] = pos;                                                 \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__sift_up(struct NAME * h, size_t pos)                                   \
+{                                                                              \
+    struct NAME##_node tmp = h->data[pos];                                     \
+                                                                               \
+    while(pos > 0)                                                             \
+    {                                                                          \
+        size_t parent = (pos - 1) / (ARITY);                                   \
+        if(!NAME##__less(&tmp.data, &h->data[parent].data)) break;             \
+                                                                               \
+        NAME##__place(h, pos, h->data[parent]);                                \
+        pos = parent;                                                          \
+    }                                                                          \
+                                                                               \
+    NAME##__place(h, pos, tmp);                                                \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__sift_down(struct NAME * h, size_t pos)                                 \
+{                                                                              \
+    struct NAME##_node tmp = h->data[pos];                                     \
+                                                                               \
+    for(;;)                                                                    \
+    {                                                                          \
+        if(pos > (h->size - 1) / (ARITY)) break;                               \
+                                                                               \
+        size_t first = pos * (ARITY) + 1;                                      \
+        if(first >= h->size) break;                                            \
+                                                                               \
+        size_t end = ((h->size - first) > (ARITY)) ?                           \
+            first + (ARITY) : h->size;                                         \
+                                                                               \
+        size_t best = first;                                                   \
+        size_t i;                                                              \
+        for(i = first + 1; i < end; i++)                                       \
+        {                                                                      \
+            if(NAME##__less(&h->data[i].data, &h->data[best].data))            \
+                best = i;                                                      \
+        }                                                                      \
+                                                                               \
+        if(!NAME##__less(&h->data[best].data, &tmp.data)) break;               \
+                                                                               \
+        NAME##__place(h, pos, h->data[best]);                                  \
+        pos = best;                                                            \
+    }                                                                          \
+                                                                               \
+    NAME##__place(h, pos, tmp);                                                \
+}                                                                              \
+                                                                               \
+/* Removes the node at `pos` and releases its handle. */                       \
+static inline void                                                             \
+NAME##__remove_at(struct NAME * h, size_t pos)                                 \
+{                                                                              \
+    NAME##__release_handle(h, h->data[pos].handle);                            \
+                                                                               \
+    --(h->size);                                                               \
+    if(pos == h->size) return;                                                 \
+                                                                               \
+    NAME##__place(h, pos, h->data[h->size]);                                   \
+                                                                               \
+    if((pos > 0) &&                                                            \
+       NAME##__less(&h->data[pos].data, &h->data[(pos - 1) / (ARITY)].data))   \
+        NAME##__sift_up(h, pos);                                               \
+    else                                                                       \
+        NAME##__sift_down(h, pos);                                             \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * h)                                                 \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    free(h->data);                                                             \
+    free(h->pos);                                                              \
+    h->data = NULL;                                                            \
+    h->pos = NULL;                                                             \
+    h->size = 0;                                                               \
+    h->cap = 0;                                                                \
+    h->free_head = 0;                                                          \
+    h->next_handle = 0;                                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_push(struct NAME * h, TYPE data, size_t* handle)                        \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    int status = NAME##__reserve(h, 1);                                        \
+    if(status != 0) return status;                                             \
+                                                                               \
+    struct NAME##_node node;                                                   \
+    node.data = data;                                                          \
+    node.handle = NAME##__take_handle(h);                                      \
+                                                                               \
+    NAME##__place(h, h->size, node);                                           \
+    ++(h->size);                                                               \
+    NAME##__sift_up(h, h->size - 1);                                           \
+                                                                               \
+    if(handle) *handle = node.handle;                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pop(struct NAME * h, TYPE * out)                                        \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+    if(h->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    if(out) *out = h->data[0].data;                                            \
+                                                                               \
+    NAME##__remove_at(h, 0);                                                   \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX struct NAME##_node *                                                 \
+NAME##_peek(struct NAME * h)                                                   \
+{                                                                              \
+    if(!h || (h->size == 0)) return NULL;                                      \
+                                                                               \
+    return &h->data[0];                                                        \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_get(struct NAME * h, size_t handle)                                     \
+{                                                                              \
+    if(!h || !NAME##__valid(h, handle)) return NULL;                           \
+                                                                               \
+    return &h->data[h->pos[handle]].data;                                      \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_decrease_key(struct NAME * h, size_t handle, TYPE data)                 \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+    if(!NAME##__valid(h, handle)) return GENC_ERR_NO_DATA;                     \
+                                                                               \
+    size_t pos = h->pos[handle];                                               \
+    if(NAME##__less(&h->data[pos].data, &data)) return GENC_ERR_INV_ARG;       \
+                                                                               \
+    h->data[pos].data = data;                                                  \
+    NAME##__sift_up(h, pos);                                                   \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_update(struct NAME * h, size_t handle, TYPE data)                       \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+    if(!NAME##__valid(h, handle)) return GENC_ERR_NO_DATA;                     \
+                                                                               \
+    size_t pos = h->pos[handle];                                               \
+    bool up = NAME##__less(&data, &h->data[pos].data);                         \
+                                                                               \
+    h->data[pos].data = data;                                                  \
+                                                                               \
+    if(up)                                                                     \
+        NAME##__sift_up(h, pos);                                               \
+    else                                                                       \
+        NAME##__sift_down(h, pos);                                             \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_erase(struct NAME * h, size_t handle, TYPE * out)                       \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+    if(!NAME##__valid(h, handle)) return GENC_ERR_NO_DATA;                     \
+                                                                               \
+    size_t pos = h->pos[handle];                                               \
+    if(out) *out = h->data[pos].data;                                          \
+                                                                               \
+    NAME##__remove_at(h, pos);                                                 \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_heapify(struct NAME * h, TYPE const * data, size_t count,               \
+               size_t* handles)                                                \
+{                                                                              \
+    if(!h || (!data && (count > 0))) return GENC_ERR_INV_ARG;                  \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    int status = NAME##__reserve(h, count);                                    \
+    if(status != 0) return status;                                             \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < count; i++)                                                 \
+    {                                                                          \
+        struct NAME##_node node;                                               \
+        node.data = data[i];                                                   \
+        node.handle = NAME##__take_handle(h);                                  \
+                                                                               \
+        NAME##__place(h, h->size + i, node);                                   \
+        if(handles) handles[i] = node.handle;                                  \
+    }                                                                          \
+    h->size += count;                                                          \
+                                                                               \
+    for(i = (h->size - 1) / (ARITY) + 1; i > 0; i--)                           \
+        NAME##__sift_down(h, i - 1);                                           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * h)                                                  \
+{                                                                              \
+    if(!h) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    h->size = 0;                                                               \
+    h->free_head = 0;                                                          \
+    h->next_handle = 0;                                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* INDEXED HEAP - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_IHEAP_INLINE(NAME, TYPE, LESS_EXPR, ARITY)                        \
+    GENC_IHEAP_DECLARE(NAME, TYPE, static inline)                              \
+    GENC_IHEAP_DEFINE(NAME, TYPE, LESS_EXPR, ARITY, static inline)             \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* LIST */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_LIST_DECLARE() and GENC_LIST_DEFINE() generate a type-safe doubly-linked
+ * list API. GENC_LIST_INLINE() generates both with `static inline`.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ *
+ * GENC_LIST_DECLARE_ALLOC(), GENC_LIST_DEFINE_ALLOC() and
+ * GENC_LIST_INLINE_ALLOC() generate the same API, but the structure gains an
+ * `alloc` member through which all nodes are allocated (see ALLOCATOR). */
+
+/* ========================================================================== */
+/* LIST - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>_node
+{
+    <type> data;
+    struct <name>_node *next, *prev;
+};
+
+|----------------------------------------------------------|
+
+struct <name>
+{
+    struct <name>_node *head, *tail;
+    size_t size;
+};
+
+|----------------------------------------------------------|
+
+struct <name> (generated by the *_ALLOC variants)
+{
+    struct <name>_node *head, *tail;
+    size_t size;
+    struct genc_alloc const* alloc;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the list and frees all nodes.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+
+int <name>_deinit(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Appends an element to the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_pushb(struct <name>* list, <type> data);
+
+|----------------------------------------------------------|
+
+* Prepends an element to the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_pushf(struct <name>* list, <type> data);
+
+|----------------------------------------------------------|
+
+* Removes the last element from the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_NO_DATA: The list is empty.
+
+int <name>_popb(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Removes the first element from the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_NO_DATA: The list is empty.
+
+int <name>_popf(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Unchecked variants of <name>_pushb() and <name>_popf() for hot loops.
+* Arguments are not validated: `list` must not be NULL and must not be empty
+* when removing.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed (<name>_pushb_unchecked()).
+
+int <name>_pushb_unchecked(struct <name>* list, <type> data);
+int <name>_popf_unchecked(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Removes all elements and frees all nodes.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+
+int <name>_empty(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Inserts an element after `node`, or at the front if `node` is NULL.
+* If non-NULL, `node` must belong to `list`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_ins_after(struct <name>* list, <type> data,
+                      struct <name>_node* node);
+
+|----------------------------------------------------------|
+
+* Inserts an element before `node`. `node` must belong to `list`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` or `node` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_ins_before(struct <name>* list, <type> data,
+                       struct <name>_node* node);
+
+|----------------------------------------------------------|
+
+* Removes `node` from the list and frees it. `node` must belong to `list`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` or `node` is NULL.
+
+int <name>_rm(struct <name>* list, struct <name>_node* node);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* LIST - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* LIST - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_LIST_DECLARE(NAME, TYPE, FN_PREFIX)                               \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct NAME##_node *head, *tail;                                           \
+    size_t size;                                                               \
+};                                                                             \
+                                                                               \
+GENC_LIST_DECLARE_FNS(NAME, TYPE, FN_PREFIX)
+
+#define GENC_LIST_DECLARE_ALLOC(NAME, TYPE, FN_PREFIX)                         \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct NAME##_node *head, *tail;                                           \
+    size_t size;                                                               \
+    struct genc_alloc const* alloc;                                            \
+};                                                                             \
+                                                                               \
+GENC_LIST_DECLARE_FNS(NAME, TYPE, FN_PREFIX)
+
+#define GENC_LIST_DECLARE_FNS(NAME, TYPE, FN_PREFIX)                           \
+                                                                               \
+struct NAME##_node                                                             \
+{                                                                              \
+    TYPE data;                                                                 \
+    struct NAME##_node *next, *prev;                                           \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * l);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * l, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * l, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * l);                                                 \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_after(struct NAME * l, TYPE data, struct NAME##_node* n);           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_before(struct NAME * l, TYPE data, struct NAME##_node* n);          \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm(struct NAME * l, struct NAME##_node* n);                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_unchecked(struct NAME * l, TYPE data);                            \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf_unchecked(struct NAME * l);                                        \
+
+/* -------------------------------------------------------------------------- */
+/* LIST - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_LIST_DEFINE(NAME, TYPE, FN_PREFIX)                                \
+    GENC_LIST_DEFINE_IMPL(NAME, TYPE, FN_PREFIX,                               \
+                          GENC_MEM_STD_ALLOC, GENC_MEM_STD_FREE,               \
+                          GENC_MEM_STD_RELEASE_ALL)
+
+#define GENC_LIST_DEFINE_ALLOC(NAME, TYPE, FN_PREFIX)                          \
+    GENC_LIST_DEFINE_IMPL(NAME, TYPE, FN_PREFIX,                               \
+                          GENC_MEM_HOOK_ALLOC, GENC_MEM_HOOK_FREE,             \
+                          GENC_MEM_HOOK_RELEASE_ALL)
+
+#define GENC_LIST_DEFINE_IMPL(NAME, TYPE, FN_PREFIX, ALLOC, FREE, RELEASE_ALL) \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * l)                                                 \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(!RELEASE_ALL(l))                                                        \
+    {                                                                          \
+        struct NAME##_node* it = l->head;                                      \
+        struct NAME##_node* next;                                              \
+        while(it)                                                              \
+        {                                                                      \
+            next = it->next;                                                   \
+            FREE(l, it, sizeof(struct NAME##_node));                           \
+            it = next;                                                         \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    l->size = 0;                                                               \
+    l->head = NULL;                                                            \
+    l->tail = NULL;                                                            \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_unchecked(struct NAME * l, TYPE data)                             \
+{                                                                              \
+    struct NAME##_node* node = ALLOC(l, sizeof(struct NAME##_node));           \
+    if(GENC_UNLIKELY(node == NULL)) return GENC_ERR_ALLOC_FAIL;                \
+                                                                               \
+    node->data = data;                                                         \
+    node->next = NULL;                                                         \
+    node->prev = l->tail;                                                      \
+                                                                               \
+    if(l->tail)                                                                \
+        l->tail->next = node;                                                  \
+    else                                                                       \
+        l->head = node;                                                        \
+                                                                               \
+    l->tail = node;                                                            \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf_unchecked(struct NAME * l)                                         \
+{                                                                              \
+    struct NAME##_node* old_head = l->head;                                    \
+                                                                               \
+    l->head = old_head->next;                                                  \
+    if(l->head)                                                                \
+        l->head->prev = NULL;                                                  \
+    else                                                                       \
+        l->tail = NULL;                                                        \
+                                                                               \
+    FREE(l, old_head, sizeof(struct NAME##_node));                             \
+    --(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * l, TYPE data)                                       \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    return NAME##_pushb_unchecked(l, data);                                    \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * l, TYPE data)                                       \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    struct NAME##_node* node = ALLOC(l, sizeof(struct NAME##_node));           \
+    if(node == NULL) return GENC_ERR_ALLOC_FAIL;                               \
+                                                                               \
+    node->data = data;                                                         \
+    node->prev = NULL;                                                         \
+    node->next = NULL;                                                         \
+                                                                               \
+    if(l->size == 0)                                                           \
+    {                                                                          \
+        l->head = node;                                                        \
+        l->tail = node;                                                        \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        l->head->prev = node;                                                  \
+        node->next = l->head;                                                  \
+        l->head = node;                                                        \
+    }                                                                          \
+                                                                               \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * l)                                                   \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    return NAME##_popf_unchecked(l);                                           \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * l)                                                   \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    if(l->size == 1)                                                           \
+    {                                                                          \
+        FREE(l, l->head, sizeof(struct NAME##_node));                          \
+        l->head = NULL;                                                        \
+        l->tail = NULL;                                                        \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        struct NAME##_node* old_tail = l->tail;                                \
+        l->tail = l->tail->prev;                                               \
+        l->tail->next = NULL;                                                  \
+        FREE(l, old_tail, sizeof(struct NAME##_node));                         \
+    }                                                                          \
+                                                                               \
+    --(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * l)                                                  \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    while(l->size > 0)                                                         \
+        NAME##_popf(l);                                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_after(struct NAME * l, TYPE data, struct NAME##_node* n)            \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if((n == NULL) || (n == l->tail))                                          \
+    {                                                                          \
+        int err;                                                               \
+                                                                               \
+        if(n == NULL)                                                          \
+            err = NAME##_pushf(l, data);                                       \
+        else                                                                   \
+            err = NAME##_pushb(l, data);                                       \
+                                                                               \
+        switch(err)                                                            \
+        {                                                                      \
+            case 0:                                                            \
+                return 0;                                                      \
+            case GENC_ERR_ALLOC_FAIL:                                          \
+                return GENC_ERR_ALLOC_FAIL;                                    \
+            default:                                                           \
+                return GENC_ERR_UNEXPECTED;                                    \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    struct NAME##_node* new_node = ALLOC(l, sizeof(struct NAME##_node));       \
+    if(new_node == NULL) return GENC_ERR_ALLOC_FAIL;                           \
+                                                                               \
+    new_node->data = data;                                                     \
+                                                                               \
+    struct NAME##_node* next = n->next;                                        \
+                                                                               \
+    n->next = new_node;                                                        \
+    new_node->prev = n;                                                        \
+    new_node->next = next;                                                     \
+    next->prev = new_node;                                                     \
+                                                                               \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins_before(struct NAME * l, TYPE data, struct NAME##_node* n)           \
+{                                                                              \
+    if(!l || !n) return GENC_ERR_INV_ARG;                                      \
+                                                                               \
+    int err = NAME##_ins_after(l, data, n->prev);                              \
+                                                                               \
+    switch(err)                                                                \
+    {                                                                          \
+        case 0:                                                                \
+            return 0;                                                          \
+        case GENC_ERR_ALLOC_FAIL:                                              \
+            return GENC_ERR_ALLOC_FAIL;                                        \
+        default:                                                               \
+            return GENC_ERR_UNEXPECTED;                                        \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm(struct NAME * l, struct NAME##_node* n)                              \
+{                                                                              \
+    if(!l || !n) return GENC_ERR_INV_ARG;                                      \
+                                                                               \
+    if((n == l->head) || (n == l->tail))                                       \
+    {                                                                          \
+        int err;                                                               \
+                                                                               \
+        if(n == l->head)                                                       \
+            err = NAME##_popf(l);                                              \
+        else                                                                   \
+            err = NAME##_popb(l);                                              \
+                                                                               \
+        switch(err)                                                            \
+        {                                                                      \
+            case 0:                                                            \
+                return 0;                                                      \
+            default:                                                           \
+                return GENC_ERR_UNEXPECTED;                                    \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    struct NAME##_node* prev = n->prev;                                        \
+    struct NAME##_node* next = n->next;                                        \
+                                                                               \
+    prev->next = next;                                                         \
+    next->prev = prev;                                                         \
+                                                                               \
+    FREE(l, n, sizeof(struct NAME##_node));                                    \
+    --(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* LIST - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_LIST_INLINE(NAME, TYPE)                                           \
+    GENC_LIST_DECLARE(NAME, TYPE, static inline)                               \
+    GENC_LIST_DEFINE(NAME, TYPE, static inline)                                \
+
+#define GENC_LIST_INLINE_ALLOC(NAME, TYPE)                                     \
+    GENC_LIST_DECLARE_ALLOC(NAME, TYPE, static inline)                         \
+    GENC_LIST_DEFINE_ALLOC(NAME, TYPE, static inline)                          \
+
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* POOL LIST */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_POOL_LIST_DECLARE() and GENC_POOL_LIST_DEFINE() generate a type-safe
+ * doubly-linked list API whose nodes are allocated from an embedded
+ * struct genc_pool (see POOL). GENC_POOL_LIST_INLINE() generates both with
+ * `static inline`.
+ *
+ * The API is the same as the one generated by GENC_LIST_DEFINE(), with the
+ * addition of <name>_trim(). Removed nodes are recycled by later insertions
+ * instead of being freed. <name>_deinit() releases all slabs at once, without
+ * visiting the nodes.
+ *
+ * The generated structure must be zero-initialized before its first use. The
+ * number of nodes per slab may be configured by setting `pool.slab_size`
+ * before the first insertion. */
+
+/* ========================================================================== */
+/* POOL LIST - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    struct <name>_node *head, *tail;
+    size_t size;
+    struct genc_pool pool;
+};
+
+|----------------------------------------------------------|
+
+* Frees node slabs that hold no elements.
+* Trimming is best-effort: failure to release slabs is not an error.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+
+int <name>_trim(struct <name>* list);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* POOL LIST - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* POOL LIST - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_POOL_LIST_DECLARE(NAME, TYPE, FN_PREFIX)                          \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct NAME##_node *head, *tail;                                           \
+    size_t size;                                                               \
+    struct genc_pool pool;                                                     \
+};                                                                             \
+                                                                               \
+GENC_LIST_DECLARE_FNS(NAME, TYPE, FN_PREFIX)                                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_trim(struct NAME * l);
+
+/* -------------------------------------------------------------------------- */
+/* POOL LIST - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_POOL_LIST_DEFINE(NAME, TYPE, FN_PREFIX)                           \
+                                                                               \
+GENC_LIST_DEFINE_IMPL(NAME, TYPE, FN_PREFIX,                                   \
+                      GENC_MEM_POOL_ALLOC, GENC_MEM_POOL_FREE,                 \
+                      GENC_MEM_POOL_RELEASE_ALL)                               \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_trim(struct NAME * l)                                                   \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    return genc_pool_trim(&l->pool);                                           \
+}
+
+/* -------------------------------------------------------------------------- */
+/* POOL LIST - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_POOL_LIST_INLINE(NAME, TYPE)                                      \
+    GENC_POOL_LIST_DECLARE(NAME, TYPE, static inline)                          \
+    GENC_POOL_LIST_DEFINE(NAME, TYPE, static inline)
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* UNROLLED LIST */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_ULIST_DECLARE() and GENC_ULIST_DEFINE() generate a type-safe unrolled
+ * linked list API. GENC_ULIST_INLINE() generates both with `static inline`.
+ *
+ * Each node holds up to N elements in a contiguous array, so the per-element
+ * overhead of the two links is divided by the fill of the node and traversal
+ * touches consecutive memory. Elements occupy the range [begin, end) of
+ * their node, which lets both ends of the list grow in O(1). A full node is
+ * split in two on insertion, and a node that drops to half capacity or less
+ * after a removal is merged with a neighbor when both fit in one node. N must
+ * be at least 2.
+ *
+ * Element order is preserved by all operations. Pointers to elements are
+ * invalidated by any insertion or removal in the same node or a neighboring
+ * node.
+ *
+ * The generated structure must be zero-initialized before its first use. */
+
+/* ========================================================================== */
+/* UNROLLED LIST - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>_node
+{
+    struct <name>_node *next, *prev;
+    unsigned begin, end;
+    <type> data[<n>];
+};
+
+|----------------------------------------------------------|
+
+struct <name>
+{
+    struct <name>_node *head, *tail;
+    size_t size;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the list and frees all nodes.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+
+int <name>_deinit(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Returns a pointer to the element at `idx`, walking from the nearer end one
+* node at a time.
+
+* RETURN VALUE: Pointer to the element, NULL if `idx` is out of bounds or
+* `list` is NULL.
+
+<type>* <name>_at(struct <name>* list, size_t idx);
+
+|----------------------------------------------------------|
+
+* Appends/prepends an element to the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_pushb(struct <name>* list, <type> data);
+int <name>_pushf(struct <name>* list, <type> data);
+
+|----------------------------------------------------------|
+
+* Removes the last/first element from the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_NO_DATA: The list is empty.
+
+int <name>_popb(struct <name>* list);
+int <name>_popf(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Inserts an element at `pos`, splitting the node at `pos` if it is full.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is greater than the list size.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_ins(struct <name>* list, <type> data, size_t pos);
+
+|----------------------------------------------------------|
+
+* Removes the element at `pos`, merging its node with a neighbor if both fit
+* in one node.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `pos` is not less than the list size.
+
+int <name>_rm_at(struct <name>* list, size_t pos);
+
+|----------------------------------------------------------|
+
+* Removes all elements and frees all nodes.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+
+int <name>_empty(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Iterates over the list one node at a time. `*node` must be NULL before the
+* first call. Each call advances `*node`, stores the number of elements in
+* the node into `count` and returns a pointer to them:
+
+    struct <name>_node* node = NULL;
+    size_t count;
+    <type>* data;
+    while((data = <name>_next_chunk(&list, &node, &count)))
+        for(size_t i = 0; i < count; i++)
+            use(data[i]);
+
+* RETURN VALUE: Pointer to the elements of the next node, NULL when there are
+* no more nodes or `list`, `node` or `count` is NULL.
+
+<type>* <name>_next_chunk(struct <name>* list, struct <name>_node** node,
+                          size_t* count);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* UNROLLED LIST - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* UNROLLED LIST - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_ULIST_DECLARE(NAME, TYPE, N, FN_PREFIX)                           \
+                                                                               \
+struct NAME##_node                                                             \
+{                                                                              \
+    struct NAME##_node *next, *prev;                                           \
+    unsigned begin, end;                                                       \
+    TYPE data[N];                                                              \
+};                                                                             \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct NAME##_node *head, *tail;                                           \
+    size_t size;                                                               \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * l);                                                \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_at(struct NAME * l, size_t idx);                                        \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * l, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * l, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins(struct NAME * l, TYPE data, size_t pos);                            \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at(struct NAME * l, size_t pos);                                     \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * l);                                                 \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_next_chunk(struct NAME * l, struct NAME##_node** node,                  \
+                  size_t* count);                                              \
+
+/* -------------------------------------------------------------------------- */
+/* UNROLLED LIST - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_ULIST_DEFINE(NAME, TYPE, N, FN_PREFIX)                            \
+                                                                               \
+typedef char NAME##__cap_check[((N) >= 2) ? 1 : -1];                           \
+                                                                               \
+/* Allocates a node after `prev` (at the front if NULL), with its empty        \
+ * range starting at `at`. */                                                  \
+static inline struct NAME##_node *                                             \
+NAME##__link_new(struct NAME * l, struct NAME##_node * prev, unsigned at)      \
+{                                                                              \
+    struct NAME##_node * node = malloc(sizeof(struct NAME##_node));            \
+    if(!node) return NULL;                                                     \
+                                                                               \
+    node->begin = at;                                                          \
+    node->end = at;                                                            \
+    node->prev = prev;                                                         \
+    node->next = prev ? prev->next : l->head;                                  \
+                                                                               \
+    if(node->next) node->next->prev = node;                                    \
+    else l->tail = node;                                                       \
+                                                                               \
+    if(prev) prev->next = node;                                                \
+    else l->head = node;                                                       \
+                                                                               \
+    return node;                                                               \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__unlink(struct NAME * l, struct NAME##_node * node)                     \
+{                                                                              \
+    if(node->prev) node->prev->next = node->next;                              \
+    else l->head = node->next;                                                 \
+                                                                               \
+    if(node->next) node->next->prev = node->prev;                              \
+    else l->tail = node->prev;                                                 \
+                                                                               \
+    free(node);                                                                \
+}                                                                              \
+                                                                               \
+/* Finds the node holding `*pos` and makes `*pos` relative to its first        \
+ * element. `*pos` must be less than the list size. */                         \
+static inline struct NAME##_node *                                             \
+NAME##__locate(struct NAME * l, size_t* pos)                                   \
+{                                                                              \
+    struct NAME##_node * node;                                                 \
+                                                                               \
+    if(*pos < l->size / 2)                                                     \
+    {                                                                          \
+        node = l->head;                                                        \
+        while(*pos >= node->end - node->begin)                                 \
+        {                                                                      \
+            *pos -= node->end - node->begin;                                   \
+            node = node->next;                                                 \
+        }                                                                      \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        size_t back = l->size - *pos;                                          \
+        node = l->tail;                                                        \
+        while(back > node->end - node->begin)                                  \
+        {                                                                      \
+            back -= node->end - node->begin;                                   \
+            node = node->prev;                                                 \
+        }                                                                      \
+        *pos = (node->end - node->begin) - back;                               \
+    }                                                                          \
+                                                                               \
+    return node;                                                               \
+}                                                                              \
+                                                                               \
+/* Moves the elements of `node` to the start of its array. */                  \
+static inline void                                                             \
+NAME##__compact(struct NAME##_node * node)                                     \
+{                                                                              \
+    if(node->begin == 0) return;                                               \
+                                                                               \
+    memmove(node->data, node->data + node->begin,                              \
+            (node->end - node->begin) * sizeof(TYPE));                         \
+    node->end -= node->begin;                                                  \
+    node->begin = 0;                                                           \
+}                                                                              \
+                                                                               \
+/* Appends the elements of `src`, the node after `dst`, to `dst` and frees     \
+ * `src`. Both must fit in one node. */                                        \
+static inline void                                                             \
+NAME##__merge(struct NAME * l, struct NAME##_node * dst,                       \
+              struct NAME##_node * src)                                        \
+{                                                                              \
+    unsigned count = src->end - src->begin;                                    \
+                                                                               \
+    if(dst->end + count > (N))                                                 \
+        NAME##__compact(dst);                                                  \
+                                                                               \
+    memcpy(dst->data + dst->end, src->data + src->begin,                       \
+           count * sizeof(TYPE));                                              \
+    dst->end += count;                                                         \
+                                                                               \
+    NAME##__unlink(l, src);                                                    \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * l)                                                 \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    struct NAME##_node * it = l->head;                                         \
+    while(it)                                                                  \
+    {                                                                          \
+        struct NAME##_node * next = it->next;                                  \
+        free(it);                                                              \
+        it = next;                                                             \
+    }                                                                          \
+                                                                               \
+    l->head = NULL;                                                            \
+    l->tail = NULL;                                                            \
+    l->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_at(struct NAME * l, size_t idx)                                         \
+{                                                                              \
+    if(!l || (idx >= l->size)) return NULL;                                    \
+                                                                               \
+    struct NAME##_node * node = NAME##__locate(l, &idx);                       \
+                                                                               \
+    return &node->data[node->begin + idx];                                     \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * l, TYPE data)                                       \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    struct NAME##_node * node = l->tail;                                       \
+    if(!node || (node->end == (N)))                                            \
+    {                                                                          \
+        node = NAME##__link_new(l, l->tail, 0);                                \
+        if(!node) return GENC_ERR_ALLOC_FAIL;                                  \
+    }                                                                          \
+                                                                               \
+    node->data[node->end++] = data;                                            \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * l, TYPE data)                                       \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    struct NAME##_node * node = l->head;                                       \
+    if(!node || (node->begin == 0))                                            \
+    {                                                                          \
+        node = NAME##__link_new(l, NULL, (N));                                 \
+        if(!node) return GENC_ERR_ALLOC_FAIL;                                  \
+    }                                                                          \
+                                                                               \
+    node->data[--node->begin] = data;                                          \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * l)                                                   \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    struct NAME##_node * node = l->tail;                                       \
+    if(--node->end == node->begin)                                             \
+        NAME##__unlink(l, node);                                               \
+    --(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * l)                                                   \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    struct NAME##_node * node = l->head;                                       \
+    if(++node->begin == node->end)                                             \
+        NAME##__unlink(l, node);                                               \
+    --(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_ins(struct NAME * l, TYPE data, size_t pos)                             \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(pos > l->size) return GENC_ERR_OUT_OF_BOUNDS;                           \
+                                                                               \
+    if(pos == l->size) return NAME##_pushb(l, data);                           \
+    if(pos == 0) return NAME##_pushf(l, data);                                 \
+                                                                               \
+    size_t off = pos;                                                          \
+    struct NAME##_node * node = NAME##__locate(l, &off);                       \
+    unsigned count = node->end - node->begin;                                  \
+                                                                               \
+    if(count == (N))                                                           \
+    {                                                                          \
+        /* Split: the upper half moves to a new node after this one. */        \
+        struct NAME##_node * upper = NAME##__link_new(l, node, 0);             \
+        if(!upper) return GENC_ERR_ALLOC_FAIL;                                 \
+                                                                               \
+        unsigned half = count / 2;                                             \
+        memcpy(upper->data, node->data + node->begin + half,                   \
+               (count - half) * sizeof(TYPE));                                 \
+        upper->end = count - half;                                             \
+        node->end = node->begin + half;                                        \
+                                                                               \
+        if(off > half)                                                         \
+        {                                                                      \
+            node = upper;                                                      \
+            off -= half;                                                       \
+        }                                                                      \
+        count = node->end - node->begin;                                       \
+    }                                                                          \
+                                                                               \
+    /* Shift whichever side has room, preferring the shorter one. */           \
+    TYPE * at = node->data + node->begin + off;                                \
+    if((node->begin > 0) && ((node->end == (N)) || (off < count / 2)))         \
+    {                                                                          \
+        memmove(node->data + node->begin - 1, node->data + node->begin,        \
+                off * sizeof(TYPE));                                           \
+        --(node->begin);                                                       \
+        --at;                                                                  \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        memmove(at + 1, at, (count - off) * sizeof(TYPE));                     \
+        ++(node->end);                                                         \
+    }                                                                          \
+                                                                               \
+    *at = data;                                                                \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rm_at(struct NAME * l, size_t pos)                                      \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(pos >= l->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+                                                                               \
+    size_t off = pos;                                                          \
+    struct NAME##_node * node = NAME##__locate(l, &off);                       \
+    unsigned count = node->end - node->begin;                                  \
+    TYPE * at = node->data + node->begin + off;                                \
+                                                                               \
+    if(off < count / 2)                                                        \
+    {                                                                          \
+        memmove(node->data + node->begin + 1, node->data + node->begin,        \
+                off * sizeof(TYPE));                                           \
+        ++(node->begin);                                                       \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        memmove(at, at + 1, (count - off - 1) * sizeof(TYPE));                 \
+        --(node->end);                                                         \
+    }                                                                          \
+    --(l->size);                                                               \
+    --count;                                                                   \
+                                                                               \
+    if(count == 0)                                                             \
+    {                                                                          \
+        NAME##__unlink(l, node);                                               \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    if(count <= (N) / 2)                                                       \
+    {                                                                          \
+        struct NAME##_node * prev = node->prev;                                \
+        struct NAME##_node * next = node->next;                                \
+                                                                               \
+        if(next && (count + (next->end - next->begin) <= (N)))                 \
+            NAME##__merge(l, node, next);                                      \
+        else if(prev && (count + (prev->end - prev->begin) <= (N)))            \
+            NAME##__merge(l, prev, node);                                      \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * l)                                                  \
+{                                                                              \
+    return NAME##_deinit(l);                                                   \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_next_chunk(struct NAME * l, struct NAME##_node** node,                  \
+                  size_t* count)                                               \
+{                                                                              \
+    if(!l || !node || !count) return NULL;                                     \
+                                                                               \
+    *node = (*node) ? (*node)->next : l->head;                                 \
+    if(!(*node)) return NULL;                                                  \
+                                                                               \
+    *count = (*node)->end - (*node)->begin;                                    \
+                                                                               \
+    return (*node)->data + (*node)->begin;                                     \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* UNROLLED LIST - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_ULIST_INLINE(NAME, TYPE, N)                                       \
+    GENC_ULIST_DECLARE(NAME, TYPE, N, static inline)                           \
+    GENC_ULIST_DEFINE(NAME, TYPE, N, static inline)                            \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* INTRUSIVE LIST */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_ILIST_DECLARE() and GENC_ILIST_DEFINE() generate a type-safe intrusive
+ * doubly-linked list API. GENC_ILIST_INLINE() generates both with
+ * `static inline`.
+ *
+ * The list does not own its elements. Instead, TYPE embeds a
+ * struct genc_ilist_link member named LINK, and linking or unlinking an
+ * element only rewrites pointers. An element may be on several lists at once
+ * through different link members, but on at most one list per member.
+ *
+ * None of the generated functions allocate or fail. Passing NULL for `list`
+ * or `elem`, or an element that is not on the list where that is required, is
+ * undefined behavior.
+ *
+ * The generated structure must be zero-initialized before its first use. */
+
+/* ========================================================================== */
+/* INTRUSIVE LIST - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct genc_ilist_link
+{
+    struct genc_ilist_link *next, *prev;
+};
+
+|----------------------------------------------------------|
+
+struct <name>
+{
+    struct genc_ilist_link *head, *tail;
+    size_t size;
+};
+
+|----------------------------------------------------------|
+
+* Returns the element that contains `link`.
+
+<type>* <name>_entry(struct genc_ilist_link* link);
+
+|----------------------------------------------------------|
+
+* Returns the first/last element of the list, or NULL if it is empty.
+
+<type>* <name>_first(struct <name>* list);
+<type>* <name>_last(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Returns the element after/before `elem`, or NULL if there is none.
+
+<type>* <name>_next(<type>* elem);
+<type>* <name>_prev(<type>* elem);
+
+|----------------------------------------------------------|
+
+* Links `elem` at the back/front of the list.
+
+void <name>_pushb(struct <name>* list, <type>* elem);
+void <name>_pushf(struct <name>* list, <type>* elem);
+
+|----------------------------------------------------------|
+
+* Unlinks and returns the first/last element, or NULL if the list is empty.
+
+<type>* <name>_popf(struct <name>* list);
+<type>* <name>_popb(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Links `elem` after `pos`, or at the front if `pos` is NULL.
+* If non-NULL, `pos` must be on `list`.
+
+void <name>_ins_after(struct <name>* list, <type>* elem, <type>* pos);
+
+|----------------------------------------------------------|
+
+* Links `elem` before `pos`, or at the back if `pos` is NULL.
+* If non-NULL, `pos` must be on `list`.
+
+void <name>_ins_before(struct <name>* list, <type>* elem, <type>* pos);
+
+|----------------------------------------------------------|
+
+* Unlinks `elem`, which must be on `list`.
+
+void <name>_rm(struct <name>* list, <type>* elem);
+
+|----------------------------------------------------------|
+
+* Unlinks all elements in O(1). The links of the former elements are left
+* stale and must not be followed.
+
+void <name>_empty(struct <name>* list);
+
+|-------------------------------------------------------- */
+
+struct genc_ilist_link
+{
+    struct genc_ilist_link *next, *prev;
+};
+
+#define GENC_CONTAINER_OF(PTR, TYPE, MEMBER)                                   \
+    ((TYPE *)(void*)((char*)(PTR) - offsetof(TYPE, MEMBER)))
+
+/* ========================================================================== */
+/* INTRUSIVE LIST - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* INTRUSIVE LIST - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_ILIST_DECLARE(NAME, TYPE, FN_PREFIX)                              \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct genc_ilist_link *head, *tail;                                       \
+    size_t size;                                                               \
+};                                                                             \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_entry(struct genc_ilist_link* link);                                    \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_first(struct NAME * l);                                                 \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_last(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_next(TYPE * elem);                                                      \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_prev(TYPE * elem);                                                      \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_pushb(struct NAME * l, TYPE * elem);                                    \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_pushf(struct NAME * l, TYPE * elem);                                    \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_popf(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_popb(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_ins_after(struct NAME * l, TYPE * elem, TYPE * pos);                    \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_ins_before(struct NAME * l, TYPE * elem, TYPE * pos);                   \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_rm(struct NAME * l, TYPE * elem);                                       \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_empty(struct NAME * l);                                                 \
+
+/* -------------------------------------------------------------------------- */
+/* INTRUSIVE LIST - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_ILIST_DEFINE(NAME, TYPE, LINK, FN_PREFIX)                         \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_entry(struct genc_ilist_link* link)                                     \
+{                                                                              \
+    return link ? GENC_CONTAINER_OF(link, TYPE, LINK) : NULL;                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_first(struct NAME * l)                                                  \
+{                                                                              \
+    return NAME##_entry(l->head);                                              \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_last(struct NAME * l)                                                   \
+{                                                                              \
+    return NAME##_entry(l->tail);                                              \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_next(TYPE * elem)                                                       \
+{                                                                              \
+    return NAME##_entry(elem->LINK.next);                                      \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_prev(TYPE * elem)                                                       \
+{                                                                              \
+    return NAME##_entry(elem->LINK.prev);                                      \
+}                                                                              \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_pushb(struct NAME * l, TYPE * elem)                                     \
+{                                                                              \
+    struct genc_ilist_link* link = &elem->LINK;                                \
+                                                                               \
+    link->next = NULL;                                                         \
+    link->prev = l->tail;                                                      \
+                                                                               \
+    if(l->tail)                                                                \
+        l->tail->next = link;                                                  \
+    else                                                                       \
+        l->head = link;                                                        \
+                                                                               \
+    l->tail = link;                                                            \
+    ++(l->size);                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_pushf(struct NAME * l, TYPE * elem)                                     \
+{                                                                              \
+    struct genc_ilist_link* link = &elem->LINK;                                \
+                                                                               \
+    link->prev = NULL;                                                         \
+    link->next = l->head;                                                      \
+                                                                               \
+    if(l->head)                                                                \
+        l->head->prev = link;                                                  \
+    else                                                                       \
+        l->tail = link;                                                        \
+                                                                               \
+    l->head = link;                                                            \
+    ++(l->size);                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_rm(struct NAME * l, TYPE * elem)                                        \
+{                                                                              \
+    struct genc_ilist_link* link = &elem->LINK;                                \
+                                                                               \
+    if(link->prev)                                                             \
+        link->prev->next = link->next;                                         \
+    else                                                                       \
+        l->head = link->next;                                                  \
+                                                                               \
+    if(link->next)                                                             \
+        link->next->prev = link->prev;                                         \
+    else                                                                       \
+        l->tail = link->prev;                                                  \
+                                                                               \
+    link->next = NULL;                                                         \
+    link->prev = NULL;                                                         \
+    --(l->size);                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_popf(struct NAME * l)                                                   \
+{                                                                              \
+    TYPE * elem = NAME##_entry(l->head);                                       \
+    if(elem) NAME##_rm(l, elem);                                               \
+                                                                               \
+    return elem;                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_popb(struct NAME * l)                                                   \
+{                                                                              \
+    TYPE * elem = NAME##_entry(l->tail);                                       \
+    if(elem) NAME##_rm(l, elem);                                               \
+                                                                               \
+    return elem;                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_ins_after(struct NAME * l, TYPE * elem, TYPE * pos)                     \
+{                                                                              \
+    if(!pos)                                                                   \
+    {                                                                          \
+        NAME##_pushf(l, elem);                                                 \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    struct genc_ilist_link* link = &elem->LINK;                                \
+    struct genc_ilist_link* pos_link = &pos->LINK;                             \
+                                                                               \
+    link->prev = pos_link;                                                     \
+    link->next = pos_link->next;                                               \
+                                                                               \
+    if(pos_link->next)                                                         \
+        pos_link->next->prev = link;                                           \
+    else                                                                       \
+        l->tail = link;                                                        \
+                                                                               \
+    pos_link->next = link;                                                     \
+    ++(l->size);                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_ins_before(struct NAME * l, TYPE * elem, TYPE * pos)                    \
+{                                                                              \
+    if(!pos)                                                                   \
+    {                                                                          \
+        NAME##_pushb(l, elem);                                                 \
+        return;                                                                \
+    }                                                                          \
+                                                                               \
+    struct genc_ilist_link* link = &elem->LINK;                                \
+    struct genc_ilist_link* pos_link = &pos->LINK;                             \
+                                                                               \
+    link->next = pos_link;                                                     \
+    link->prev = pos_link->prev;                                               \
+                                                                               \
+    if(pos_link->prev)                                                         \
+        pos_link->prev->next = link;                                           \
+    else                                                                       \
+        l->head = link;                                                        \
+                                                                               \
+    pos_link->prev = link;                                                     \
+    ++(l->size);                                                               \
+}                                                                              \
+                                                                               \
+FN_PREFIX void                                                                 \
+NAME##_empty(struct NAME * l)                                                  \
+{                                                                              \
+    l->head = NULL;                                                            \
+    l->tail = NULL;                                                            \
+    l->size = 0;                                                               \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* INTRUSIVE LIST - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_ILIST_INLINE(NAME, TYPE, LINK)                                    \
+    GENC_ILIST_DECLARE(NAME, TYPE, static inline)                              \
+    GENC_ILIST_DEFINE(NAME, TYPE, LINK, static inline)                         \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* FWD LIST */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_FWD_LIST_DECLARE() and GENC_FWD_LIST_DEFINE() generate a type-safe
+ * forward list API intended for stack or queue use. GENC_FWD_LIST_INLINE()
+ * generates both with `static inline`.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ *
+ * GENC_FWD_LIST_DECLARE_ALLOC(), GENC_FWD_LIST_DEFINE_ALLOC() and
+ * GENC_FWD_LIST_INLINE_ALLOC() generate the same API, but the structure gains
+ * an `alloc` member through which all nodes are allocated (see ALLOCATOR). */
+
+/* ========================================================================== */
+/* FWD LIST - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>_node
+{
+    <type> data;
+    struct <name>_node* next;
+};
+
+|----------------------------------------------------------|
+
+struct <name>
+{
+    struct <name>_node *head, *tail;
+    size_t size;
+};
+
+|----------------------------------------------------------|
+
+struct <name> (generated by the *_ALLOC variants)
+{
+    struct <name>_node *head, *tail;
+    size_t size;
+    struct genc_alloc const* alloc;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the list and frees all nodes.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+
+int <name>_deinit(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Appends an element to the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_pushb(struct <name>* list, <type> data);
+
+|----------------------------------------------------------|
+
+* Prepends an element to the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+
+int <name>_pushf(struct <name>* list, <type> data);
+
+|----------------------------------------------------------|
+
+* Removes the first element from the list.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_NO_DATA: The list is empty.
+
+int <name>_popf(struct <name>* list);
+
+|----------------------------------------------------------|
+
+* Removes all elements and frees all nodes.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `list` is NULL.
+
+int <name>_empty(struct <name>* list);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* FWD LIST - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* FWD LIST - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_FWD_LIST_DECLARE(NAME, TYPE, FN_PREFIX)                           \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct NAME##_node *head, *tail;                                           \
+    size_t size;                                                               \
+};                                                                             \
+                                                                               \
+GENC_FWD_LIST_DECLARE_FNS(NAME, TYPE, FN_PREFIX)
+
+#define GENC_FWD_LIST_DECLARE_ALLOC(NAME, TYPE, FN_PREFIX)                     \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    struct NAME##_node *head, *tail;                                           \
+    size_t size;                                                               \
+    struct genc_alloc const* alloc;                                            \
+};                                                                             \
+                                                                               \
+GENC_FWD_LIST_DECLARE_FNS(NAME, TYPE, FN_PREFIX)
+
+#define GENC_FWD_LIST_DECLARE_FNS(NAME, TYPE, FN_PREFIX)                       \
+                                                                               \
+struct NAME##_node                                                             \
+{                                                                              \
+    TYPE data;                                                                 \
+    struct NAME##_node* next;                                                  \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * l);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * l, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * l, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * l);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * l);                                                 \
+
+/* -------------------------------------------------------------------------- */
+/* FWD LIST - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_FWD_LIST_DEFINE(NAME, TYPE, FN_PREFIX)                            \
+    GENC_FWD_LIST_DEFINE_IMPL(NAME, TYPE, FN_PREFIX,                           \
+                              GENC_MEM_STD_ALLOC, GENC_MEM_STD_FREE)
+
+#define GENC_FWD_LIST_DEFINE_ALLOC(NAME, TYPE, FN_PREFIX)                      \
+    GENC_FWD_LIST_DEFINE_IMPL(NAME, TYPE, FN_PREFIX,                           \
+                              GENC_MEM_HOOK_ALLOC, GENC_MEM_HOOK_FREE)
+
+#define GENC_FWD_LIST_DEFINE_IMPL(NAME, TYPE, FN_PREFIX, ALLOC, FREE)          \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * l)                                                 \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    struct NAME##_node* it = l->head;                                          \
+    struct NAME##_node* next;                                                  \
+    while(it)                                                                  \
+    {                                                                          \
+        next = it->next;                                                       \
+        FREE(l, it, sizeof(struct NAME##_node));                               \
+        it = next;                                                             \
+    }                                                                          \
+                                                                               \
+    l->size = 0;                                                               \
+    l->head = NULL;                                                            \
+    l->tail = NULL;                                                            \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * l, TYPE data)                                       \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    struct NAME##_node* node = ALLOC(l, sizeof(struct NAME##_node));           \
+    if(node == NULL) return GENC_ERR_ALLOC_FAIL;                               \
+                                                                               \
+    node->data = data;                                                         \
+    node->next = NULL;                                                         \
+                                                                               \
+    if(l->size == 0)                                                           \
+    {                                                                          \
+        l->head = node;                                                        \
+        l->tail = node;                                                        \
+    }                                                                          \
+    else                                                                       \
+    {                                                                          \
+        l->tail->next = node;                                                  \
+        l->tail = node;                                                        \
+    }                                                                          \
+                                                                               \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * l, TYPE data)                                       \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    struct NAME##_node* node = ALLOC(l, sizeof(struct NAME##_node));           \
+    if(node == NULL) return GENC_ERR_ALLOC_FAIL;                               \
+                                                                               \
+    node->data = data;                                                         \
+    node->next = l->head;                                                      \
+                                                                               \
+    if(l->size == 0)                                                           \
+        l->tail = node;                                                        \
+                                                                               \
+    l->head = node;                                                            \
+    ++(l->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * l)                                                   \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    struct NAME##_node* old_head = l->head;                                    \
+                                                                               \
+    l->head = l->head->next;                                                   \
+    FREE(l, old_head, sizeof(struct NAME##_node));                             \
+                                                                               \
+    --(l->size);                                                               \
+                                                                               \
+    if(l->size == 0)                                                           \
+        l->tail = NULL;                                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * l)                                                  \
+{                                                                              \
+    if(!l) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    while(l->size > 0)                                                         \
+        NAME##_popf(l);                                                        \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* FWD LIST - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_FWD_LIST_INLINE(NAME, TYPE)                                       \
+    GENC_FWD_LIST_DECLARE(NAME, TYPE, static inline)                           \
+    GENC_FWD_LIST_DEFINE(NAME, TYPE, static inline)                            \
+
+#define GENC_FWD_LIST_INLINE_ALLOC(NAME, TYPE)                                 \
+    GENC_FWD_LIST_DECLARE_ALLOC(NAME, TYPE, static inline)                     \
+    GENC_FWD_LIST_DEFINE_ALLOC(NAME, TYPE, static inline)                      \
+
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* DEQUE */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_DEQUE_DECLARE() and GENC_DEQUE_DEFINE() generate a type-safe
+ * double-ended queue API backed by a contiguous circular buffer.
+ * GENC_DEQUE_INLINE() generates both with `static inline`.
+ *
+ * Element `i` (counted from the front) is stored at
+ * `data[(head + i) & (cap - 1)]`. Bulk operations copy at most two contiguous
+ * segments.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ *
+ * GROWF has the same meaning as for GENC_VECTOR, except that capacity is
+ * always a power of two: the capacity derived from GROWF is rounded up to the
+ * next power of two. */
+
+/* ========================================================================== */
+/* DEQUE - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    <type>* data;
+    size_t head;
+    size_t size;
+    size_t cap;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the deque and frees allocated memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL.
+
+int <name>_deinit(struct <name>* deque);
+
+|----------------------------------------------------------|
+
+* Returns a pointer to the element at `idx`, counted from the front.
+* The pointer is invalidated by any operation that inserts elements.
+
+* RETURN VALUE: Pointer to the element, NULL if `deque` is NULL or `idx` is
+* outside the deque.
+
+<type>* <name>_at(struct <name>* deque, size_t idx);
+
+|----------------------------------------------------------|
+
+* Appends/prepends an element.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_pushb(struct <name>* deque, <type> data);
+int <name>_pushf(struct <name>* deque, <type> data);
+
+|----------------------------------------------------------|
+
+* Removes the last/first element.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL.
+* GENC_ERR_NO_DATA: The deque is empty.
+
+int <name>_popb(struct <name>* deque);
+int <name>_popf(struct <name>* deque);
+
+|----------------------------------------------------------|
+
+* Appends/prepends `count` elements from `data`. Their order is preserved:
+* after <name>_pushf_many(), `data[0]` is the first element of the deque.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL, or `data` is NULL when `count` is
+* nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_pushb_many(struct <name>* deque, <type> const* data, size_t count);
+int <name>_pushf_many(struct <name>* deque, <type> const* data, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes `count` elements from the back/front. If `out` is non-NULL, the
+* removed elements are copied to it in front-to-back order.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL.
+* GENC_ERR_OUT_OF_BOUNDS: `count` is greater than the deque size.
+
+int <name>_popb_many(struct <name>* deque, <type>* out, size_t count);
+int <name>_popf_many(struct <name>* deque, <type>* out, size_t count);
+
+|----------------------------------------------------------|
+
+* Removes all elements while retaining allocated capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL.
+
+int <name>_empty(struct <name>* deque);
+
+|----------------------------------------------------------|
+
+* Shrinks allocated capacity when the deque is sufficiently sparse.
+* The shrink threshold and resulting capacity are derived from GROWF.
+* If the deque is empty, all allocated storage is freed.
+* Shrinking is best-effort: failure to reduce capacity is not an error.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL.
+
+int <name>_shrink(struct <name>* deque);
+
+|----------------------------------------------------------|
+
+* Increases deque capacity by at least `size` elements.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `deque` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_prealloc(struct <name>* deque, size_t size);
+
+|-------------------------------------------------------- */
+
+/* Returns the smallest power of two that is not less than `val`, or 0 if it
+ * cannot be represented. */
+static inline size_t
+genc_pow2_ceil(size_t val)
+{
+    size_t pow2 = 1;
+    while(pow2 < val)
+    {
+        if(pow2 > SIZE_MAX / 2) return 0;
+        pow2 <<= 1;
+    }
+
+    return pow2;
+}
+
+/* ========================================================================== */
+/* DEQUE - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* DEQUE - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_DEQUE_DECLARE(NAME, TYPE, FN_PREFIX)                              \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    TYPE * data;                                                               \
+    size_t head;                                                               \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+};                                                                             \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * d);                                                \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_at(struct NAME * d, size_t idx);                                        \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * d, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * d, TYPE data);                                      \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * d);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * d);                                                  \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_many(struct NAME * d, TYPE const * data, size_t count);           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf_many(struct NAME * d, TYPE const * data, size_t count);           \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many(struct NAME * d, TYPE * out, size_t count);                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf_many(struct NAME * d, TYPE * out, size_t count);                   \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * d);                                                 \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_shrink(struct NAME * d);                                                \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_prealloc(struct NAME * d, size_t size);                                 \
+
+/* -------------------------------------------------------------------------- */
+/* DEQUE - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_DEQUE_DEFINE(NAME, TYPE, GROWF, FN_PREFIX)                        \
+                                                                               \
+static inline void                                                             \
+NAME##__copy_in(struct NAME * d, size_t pos, TYPE const * src, size_t count)   \
+{                                                                              \
+    size_t first = d->cap - pos;                                               \
+    if(first > count) first = count;                                           \
+                                                                               \
+    memcpy(d->data + pos, src, first * sizeof(TYPE));                          \
+    memcpy(d->data, src + first, (count - first) * sizeof(TYPE));              \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__copy_out(struct NAME * d, size_t pos, TYPE * dst, size_t count)        \
+{                                                                              \
+    size_t first = d->cap - pos;                                               \
+    if(first > count) first = count;                                           \
+                                                                               \
+    memcpy(dst, d->data + pos, first * sizeof(TYPE));                          \
+    memcpy(dst + first, d->data, (count - first) * sizeof(TYPE));              \
+}                                                                              \
+                                                                               \
+/* Grows the buffer to `new_cap`, a power of two larger than `d->cap`, and     \
+ * unwraps the elements that wrapped around the old end. */                    \
+static inline int                                                              \
+NAME##__resize(struct NAME * d, size_t new_cap)                                \
+{                                                                              \
+    if(new_cap > SIZE_MAX / sizeof(TYPE))                                      \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    TYPE * new_data = realloc(d->data, new_cap * sizeof(TYPE));                \
+    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+                                                                               \
+    size_t old_cap = d->cap;                                                   \
+                                                                               \
+    if(d->head + d->size > old_cap)                                            \
+    {                                                                          \
+        size_t first = old_cap - d->head;                                      \
+        size_t wrapped = d->size - first;                                      \
+                                                                               \
+        if(wrapped <= first)                                                   \
+        {                                                                      \
+            memcpy(new_data + old_cap, new_data, wrapped * sizeof(TYPE));      \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            memcpy(new_data + new_cap - first, new_data + d->head,             \
+                   first * sizeof(TYPE));                                      \
+            d->head = new_cap - first;                                         \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    d->data = new_data;                                                        \
+    d->cap = new_cap;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##__grow(struct NAME * d, size_t count)                                    \
+{                                                                              \
+    if(count > SIZE_MAX - d->size)                                             \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    size_t req_cap = d->size + count;                                          \
+    if(req_cap <= d->cap) return 0;                                            \
+                                                                               \
+    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+                                                                               \
+    size_t new_cap = (size_t)((double)d->cap * growf_adj);                     \
+    if(new_cap < req_cap)                                                      \
+        new_cap = req_cap;                                                     \
+                                                                               \
+    new_cap = genc_pow2_ceil(new_cap);                                         \
+    if(new_cap == 0) return GENC_ERR_ALLOC_FAIL;                               \
+                                                                               \
+    return NAME##__resize(d, new_cap);                                         \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_deinit(struct NAME * d)                                                 \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    free(d->data);                                                             \
+    d->data = NULL;                                                            \
+    d->head = 0;                                                               \
+    d->size = 0;                                                               \
+    d->cap = 0;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX TYPE *                                                               \
+NAME##_at(struct NAME * d, size_t idx)                                         \
+{                                                                              \
+    if(!d || (idx >= d->size)) return NULL;                                    \
+                                                                               \
+    return &d->data[(d->head + idx) & (d->cap - 1)];                           \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb(struct NAME * d, TYPE data)                                       \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(d->size == d->cap)                                                      \
+    {                                                                          \
+        int status = NAME##__grow(d, 1);                                       \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    d->data[(d->head + d->size) & (d->cap - 1)] = data;                        \
+    ++(d->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf(struct NAME * d, TYPE data)                                       \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(d->size == d->cap)                                                      \
+    {                                                                          \
+        int status = NAME##__grow(d, 1);                                       \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    d->head = (d->head + d->cap - 1) & (d->cap - 1);                           \
+    d->data[d->head] = data;                                                   \
+    ++(d->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb(struct NAME * d)                                                   \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+    if(d->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    --(d->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popf(struct NAME * d)                                                   \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+    if(d->size == 0) return GENC_ERR_NO_DATA;                                  \
+                                                                               \
+    d->head = (d->head + 1) & (d->cap - 1);                                    \
+    --(d->size);                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushb_many(struct NAME * d, TYPE const * data, size_t count)            \
+{                                                                              \
+    if(!d || (!data && count > 0))                                             \
+        return GENC_ERR_INV_ARG;                                               \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    int status = NAME##__grow(d, count);                                       \
+    if(status != 0) return status;                                             \
+                                                                               \
+    NAME##__copy_in(d, (d->head + d->size) & (d->cap - 1), data, count);       \
+    d->size += count;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_pushf_many(struct NAME * d, TYPE const * data, size_t count)            \
+{                                                                              \
+    if(!d || (!data && count > 0))                                             \
+        return GENC_ERR_INV_ARG;                                               \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    int status = NAME##__grow(d, count);                                       \
+    if(status != 0) return status;                                             \
+                                                                               \
+    d->head = (d->head + d->cap - count) & (d->cap - 1);                       \
+    NAME##__copy_in(d, d->head, data, count);                                  \
+    d->size += count;                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_popb_many(struct NAME * d, TYPE * out, size_t count)                    \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+    if(count > d->size) return GENC_ERR_OUT_OF_BOUNDS;                         \
+                                                                               \
+    if(count == 0) return 0;                                                   \
+                                                                               \
+    if(out)                                                                    \
+    {                                                                          \
+        size_t pos = (d->head + d->size - count) & (d->cap - 1);               \
+        NAME##__copy_out(d, pos, out, count);                                  \
+    }                                                                          \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_pushb_many(struct NAME * v, TYPE const * data, size_t count);           \
+    d->size -= count;                                                          \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_rm_at_many(struct NAME * v, size_t pos, size_t count);                  \
+    return 0;                                                                  \
+}                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb_many(struct NAME * v, size_t count);                               \
+NAME##_popf_many(struct NAME * d, TYPE * out, size_t count)                    \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+    if(count > d->size) return GENC_ERR_OUT_OF_BOUNDS;                         \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_shrink(struct NAME * v);                                                \
+    if(count == 0) return 0;                                                   \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_rm_at_many_shrink(struct NAME * v, size_t pos, size_t count);           \
+    if(out)                                                                    \
+        NAME##__copy_out(d, d->head, out, count);                              \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_popb_many_shrink(struct NAME * v, size_t count);                        \
+    d->head = (d->head + count) & (d->cap - 1);                                \
+    d->size -= count;                                                          \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_ins(struct NAME * v, TYPE data, size_t pos);                            \
+    return 0;                                                                  \
+}                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushb(struct NAME * v, TYPE data);                                      \
+NAME##_empty(struct NAME * d)                                                  \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_rm_at(struct NAME * v, size_t pos);                                     \
+    d->head = 0;                                                               \
+    d->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb(struct NAME * v);                                                  \
+NAME##_shrink(struct NAME * d)                                                 \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(d->size == 0)                                                           \
+    {                                                                          \
+        free(d->data);                                                         \
+        d->data = NULL;                                                        \
+        d->head = 0;                                                           \
+        d->cap = 0;                                                            \
+                                                                               \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+    size_t threshold = (size_t)((double)d->cap / growf_adj / growf_adj);       \
+                                                                               \
+    if(d->size < threshold)                                                    \
+    {                                                                          \
+        size_t new_cap = (size_t)((double)d->size * growf_adj);                \
+        if(new_cap < d->size) new_cap = d->size;                               \
+                                                                               \
+        new_cap = genc_pow2_ceil(new_cap);                                     \
+        if((new_cap == 0) || (new_cap >= d->cap)) return 0;                    \
+                                                                               \
+        TYPE * new_data = malloc(new_cap * sizeof(TYPE));                      \
+        if(!new_data) return 0;                                                \
+                                                                               \
+        NAME##__copy_out(d, d->head, new_data, d->size);                       \
+        free(d->data);                                                         \
+                                                                               \
+        d->data = new_data;                                                    \
+        d->head = 0;                                                           \
+        d->cap = new_cap;                                                      \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_rm_at_shrink(struct NAME * v, size_t pos);                              \
+NAME##_prealloc(struct NAME * d, size_t size)                                  \
+{                                                                              \
+    if(!d) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(size == 0) return 0;                                                    \
+                                                                               \
+    if(size > SIZE_MAX - d->cap)                                               \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    size_t new_cap = genc_pow2_ceil(d->cap + size);                            \
+    if(new_cap == 0) return GENC_ERR_ALLOC_FAIL;                               \
+                                                                               \
+    return NAME##__resize(d, new_cap);                                         \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* DEQUE - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_DEQUE_INLINE(NAME, TYPE, GROWF)                                   \
+    GENC_DEQUE_DECLARE(NAME, TYPE, static inline)                              \
+    GENC_DEQUE_DEFINE(NAME, TYPE, GROWF, static inline)                        \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* HASH TABLE */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* Open-addressing engine shared by GENC_HMAP and GENC_HSET. Not meant to be
+ * used directly.
+ *
+ * Slots are stored in one flat array, next to an array of control bytes: 0x80
+ * marks an empty slot, and values below 0x80 mark a full slot and hold 7 bits
+ * of its key's hash. Probing is linear, but examines the control bytes of 16
+ * consecutive slots at once (with SSE2 when available, GENC_HAS_SSE2), so most
+ * lookups compare a single key. The first 16 control bytes are mirrored past
+ * the end of the array, so a group never needs to wrap.
+ *
+ * Deletion uses backward shifting instead of tombstones: the elements that
+ * follow the removed one in its probe run are moved back, so lookups never
+ * skip over deleted slots and the table never needs to be rebuilt to purge
+ * them.
+ *
+ * HASH_FN(key) must return an integer hash of `key`; its bits are mixed with
+ * genc_hash_u64(), so identity hashes of integers are acceptable.
+ * EQ_FN(a, b) must return nonzero if the keys `a` and `b` are equal. Both may
+ * be functions or function-like macros. */
+
+#define GENC_HTABLE_GROUP 16
+#define GENC_HTABLE_EMPTY 0x80
+
+#ifndef GENC_HTABLE_DEFAULT_LOAD
+#define GENC_HTABLE_DEFAULT_LOAD 0.75
+#endif // GENC_HTABLE_DEFAULT_LOAD
+
+/* ========================================================================== */
+/* HASH TABLE - HASH FUNCTIONS */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+* Mixes the bits of `val` (Murmur3 finalizer).
+
+uint64_t genc_hash_u64(uint64_t val);
+
+|----------------------------------------------------------|
+
+* Hashes `size` bytes at `data` (FNV-1a).
+
+uint64_t genc_hash_bytes(void const* data, size_t size);
+
+|----------------------------------------------------------|
+
+* Hashes the NUL-terminated string `str` (FNV-1a).
+
+uint64_t genc_hash_str(char const* str);
+
+|-------------------------------------------------------- */
+
+static inline uint64_t
+genc_hash_u64(uint64_t val)
+{
+    val ^= val >> 33;
+    val *= UINT64_C(0xff51afd7ed558ccd);
+    val ^= val >> 33;
+    val *= UINT64_C(0xc4ceb9fe1a85ec53);
+    val ^= val >> 33;
+
+    return val;
+}
+
+static inline uint64_t
+genc_hash_bytes(void const* data, size_t size)
+{
+    unsigned char const* bytes = data;
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+
+    size_t i;
+    for(i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= UINT64_C(0x100000001b3);
+    }
+
+    return hash;
+}
+
+static inline uint64_t
+genc_hash_str(char const* str)
+{
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+
+    for(; *str; str++)
+    {
+        hash ^= (unsigned char)*str;
+        hash *= UINT64_C(0x100000001b3);
+    }
+
+    return hash;
+}
+
+/* ========================================================================== */
+/* HASH TABLE - GROUP PROBING */
+/* ========================================================================== */
+
+/* Returns a mask with bit `i` set if `ctrl[i]` equals `h2`. */
+static inline uint32_t
+genc_htable_match(uint8_t const* ctrl, uint8_t h2)
+{
+#ifdef GENC_HAS_SSE2
+    __m128i group = _mm_loadu_si128((__m128i const*)(void const*)ctrl);
+    __m128i cmp = _mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2));
+
+    return (uint32_t)_mm_movemask_epi8(cmp);
+#else
+    uint32_t mask = 0;
+
+    unsigned i;
+    for(i = 0; i < GENC_HTABLE_GROUP; i++)
+        mask |= (uint32_t)(ctrl[i] == h2) << i;
+
+    return mask;
+#endif
+}
+
+/* Returns a mask with bit `i` set if `ctrl[i]` is empty. */
+static inline uint32_t
+genc_htable_match_empty(uint8_t const* ctrl)
+{
+#ifdef GENC_HAS_SSE2
+    __m128i group = _mm_loadu_si128((__m128i const*)(void const*)ctrl);
+
+    return (uint32_t)_mm_movemask_epi8(group);
+#else
+    uint32_t mask = 0;
+
+    unsigned i;
+    for(i = 0; i < GENC_HTABLE_GROUP; i++)
+        mask |= (uint32_t)(ctrl[i] >> 7) << i;
+
+    return mask;
+#endif
+}
+
+/* ========================================================================== */
+/* HASH TABLE - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* HASH TABLE - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+/* Expects `struct NAME##_slot` with a `key` member to be declared. */
+#define GENC_HTABLE_DECLARE_IMPL(NAME, KEY, FN_PREFIX)                         \
+                                                                               \
+struct NAME                                                                    \
+{                                                                              \
+    uint8_t* ctrl;                                                             \
+    struct NAME##_slot * slots;                                                \
+    size_t size;                                                               \
+    size_t cap;                                                                \
+    double max_load;                                                           \
+};                                                                             \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb_shrink(struct NAME * v);                                           \
+NAME##_deinit(struct NAME * m);                                                \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty(struct NAME * v);                                                 \
+NAME##_empty(struct NAME * m);                                                 \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty_shrink(struct NAME * v);                                          \
+NAME##_reserve(struct NAME * m, size_t count);                                 \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_fit(struct NAME * v);                                                   \
+NAME##_rehash(struct NAME * m, size_t count);                                  \
+                                                                               \
+FN_PREFIX bool                                                                 \
+NAME##_has(struct NAME * m, KEY key);                                          \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_prealloc(struct NAME * v, size_t size);
+NAME##_rm(struct NAME * m, KEY key);                                           \
+                                                                               \
+FN_PREFIX struct NAME##_slot *                                                 \
+NAME##_next(struct NAME * m, size_t* it);                                      \
 
 /* -------------------------------------------------------------------------- */
-/* VECTOR - DEFINE */
+/* HASH TABLE - DEFINE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_VECTOR_DEFINE(NAME, TYPE, GROWF, FN_PREFIX)                       \
+#define GENC_HTABLE_DEFINE_IMPL(NAME, KEY, HASH_FN, EQ_FN, FN_PREFIX)          \
+                                                                               \
+static inline uint64_t                                                         \
+NAME##__hash(KEY key)                                                          \
+{                                                                              \
+    return genc_hash_u64((uint64_t)(HASH_FN(key)));                            \
+}                                                                              \
+                                                                               \
+static inline double                                                           \
+NAME##__load(struct NAME * m)                                                  \
+{                                                                              \
+    double load = m->max_load;                                                 \
+                                                                               \
+    if(load <= 0.0) return GENC_HTABLE_DEFAULT_LOAD;                           \
+    if(load < 0.25) return 0.25;                                               \
+    if(load > 0.95) return 0.95;                                               \
+                                                                               \
+    return load;                                                               \
+}                                                                              \
+                                                                               \
+static inline void                                                             \
+NAME##__set_ctrl(struct NAME * m, size_t idx, uint8_t val)                     \
+{                                                                              \
+    m->ctrl[idx] = val;                                                        \
+    if(idx < GENC_HTABLE_GROUP)                                                \
+        m->ctrl[m->cap + idx] = val;                                           \
+}                                                                              \
+                                                                               \
+/* Returns the index of `key`, or SIZE_MAX if it is absent. */                 \
+static inline size_t                                                           \
+NAME##__find(struct NAME * m, KEY key, uint64_t hash)                          \
+{                                                                              \
+    if(m->cap == 0) return SIZE_MAX;                                           \
+                                                                               \
+    size_t mask = m->cap - 1;                                                  \
+    size_t pos = (size_t)(hash >> 7) & mask;                                   \
+    uint8_t h2 = (uint8_t)(hash & 0x7F);                                       \
+                                                                               \
+    for(;;)                                                                    \
+    {                                                                          \
+        uint32_t match = genc_htable_match(m->ctrl + pos, h2);                 \
+        uint32_t empty = genc_htable_match_empty(m->ctrl + pos);               \
+                                                                               \
+        /* A key never sits past the first empty slot of its probe run. */     \
+        if(empty) match &= (empty & (0u - empty)) - 1;                         \
+                                                                               \
+        while(match)                                                           \
+        {                                                                      \
+            size_t idx = (pos + genc_ctz32(match)) & mask;                     \
+            if(EQ_FN(m->slots[idx].key, key)) return idx;                      \
+            match &= match - 1;                                                \
+        }                                                                      \
+                                                                               \
+        if(empty) return SIZE_MAX;                                             \
+                                                                               \
+        pos = (pos + GENC_HTABLE_GROUP) & mask;                                \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+/* Returns the first empty slot of the probe run of `hash`. */                 \
+static inline size_t                                                           \
+NAME##__find_empty(struct NAME * m, uint64_t hash)                             \
+{                                                                              \
+    size_t mask = m->cap - 1;                                                  \
+    size_t pos = (size_t)(hash >> 7) & mask;                                   \
+                                                                               \
+    for(;;)                                                                    \
+    {                                                                          \
+        uint32_t empty = genc_htable_match_empty(m->ctrl + pos);               \
+        if(empty) return (pos + genc_ctz32(empty)) & mask;                     \
+                                                                               \
+        pos = (pos + GENC_HTABLE_GROUP) & mask;                                \
+    }                                                                          \
+}                                                                              \
+                                                                               \
+/* Returns the capacity needed to hold `count` elements. */                    \
+static inline size_t                                                           \
+NAME##__cap_for(struct NAME * m, size_t count)                                 \
+{                                                                              \
+    double need = (double)count / NAME##__load(m) + 1.0;                       \
+    if(need >= (double)(SIZE_MAX / 2)) return 0;                               \
+                                                                               \
+    size_t cap = genc_pow2_ceil((size_t)need);                                 \
+    if((cap != 0) && (cap < GENC_HTABLE_GROUP))                                \
+        cap = GENC_HTABLE_GROUP;                                               \
+                                                                               \
+    return cap;                                                                \
+}                                                                              \
+                                                                               \
+static inline int                                                              \
+NAME##__resize(struct NAME * m, size_t new_cap)                                \
+{                                                                              \
+    if((new_cap == 0) ||                                                       \
+       (new_cap > SIZE_MAX / sizeof(struct NAME##_slot)) ||                    \
+       (new_cap > SIZE_MAX - GENC_HTABLE_GROUP))                               \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    uint8_t* new_ctrl = malloc(new_cap + GENC_HTABLE_GROUP);                   \
+    struct NAME##_slot * new_slots =                                           \
+        malloc(new_cap * sizeof(struct NAME##_slot));                          \
+                                                                               \
+    if(!new_ctrl || !new_slots)                                                \
+    {                                                                          \
+        free(new_ctrl);                                                        \
+        free(new_slots);                                                       \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+    }                                                                          \
+                                                                               \
+    memset(new_ctrl, GENC_HTABLE_EMPTY, new_cap + GENC_HTABLE_GROUP);          \
+                                                                               \
+    struct NAME old = *m;                                                      \
+                                                                               \
+    m->ctrl = new_ctrl;                                                        \
+    m->slots = new_slots;                                                      \
+    m->cap = new_cap;                                                          \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < old.cap; i++)                                               \
+    {                                                                          \
+        if(old.ctrl[i] & GENC_HTABLE_EMPTY) continue;                          \
+                                                                               \
+        uint64_t hash = NAME##__hash(old.slots[i].key);                        \
+        size_t idx = NAME##__find_empty(m, hash);                              \
+                                                                               \
+        NAME##__set_ctrl(m, idx, (uint8_t)(hash & 0x7F));                      \
+        m->slots[idx] = old.slots[i];                                          \
+    }                                                                          \
+                                                                               \
+    free(old.ctrl);                                                            \
+    free(old.slots);                                                           \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/* Finds `key`, or claims a slot for it and stores the key. Sets `*found`      \
+ * accordingly and `*idx` to the slot index. */                                \
+static inline int                                                              \
+NAME##__claim(struct NAME * m, KEY key, size_t* idx, bool* found)              \
+{                                                                              \
+    uint64_t hash = NAME##__hash(key);                                         \
+                                                                               \
+    size_t pos = NAME##__find(m, key, hash);                                   \
+    if(pos != SIZE_MAX)                                                        \
+    {                                                                          \
+        *idx = pos;                                                            \
+        *found = true;                                                         \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    if((double)(m->size + 1) > (double)m->cap * NAME##__load(m))               \
+    {                                                                          \
+        size_t new_cap = (m->cap > 0) ?                                        \
+            m->cap * 2 : NAME##__cap_for(m, m->size + 1);                      \
+        if((new_cap == 0) || (new_cap < m->cap))                               \
+            return GENC_ERR_ALLOC_FAIL;                                        \
+                                                                               \
+        int status = NAME##__resize(m, new_cap);                               \
+        if(status != 0) return status;                                         \
+    }                                                                          \
+                                                                               \
+    pos = NAME##__find_empty(m, hash);                                         \
+    NAME##__set_ctrl(m, pos, (uint8_t)(hash & 0x7F));                          \
+    m->slots[pos].key = key;                                                   \
+    ++(m->size);                                                               \
+                                                                               \
+    *idx = pos;                                                                \
+    *found = false;                                                            \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+/* Removes the element at `idx` and shifts back the rest of its probe run. */  \
+static inline void                                                             \
+NAME##__erase_at(struct NAME * m, size_t idx)                                  \
+{                                                                              \
+    size_t mask = m->cap - 1;                                                  \
+    size_t hole = idx;                                                         \
+    size_t it = idx;                                                           \
+                                                                               \
+    for(;;)                                                                    \
+    {                                                                          \
+        it = (it + 1) & mask;                                                  \
+        if(m->ctrl[it] & GENC_HTABLE_EMPTY) break;                             \
+                                                                               \
+        size_t home = (size_t)(NAME##__hash(m->slots[it].key) >> 7) & mask;    \
+                                                                               \
+        /* The element may move into the hole if the hole lies between its     \
+         * home slot and its current slot. */                                  \
+        if(((hole - home) & mask) < ((it - home) & mask))                      \
+        {                                                                      \
+            m->slots[hole] = m->slots[it];                                     \
+            NAME##__set_ctrl(m, hole, m->ctrl[it]);                            \
+            hole = it;                                                         \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    NAME##__set_ctrl(m, hole, GENC_HTABLE_EMPTY);                              \
+    --(m->size);                                                               \
+}                                                                              \
+                                                                               \
 FN_PREFIX int                                                                  \
-NAME##_deinit(struct NAME * v)                                                 \
+NAME##_deinit(struct NAME * m)                                                 \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    free(v->data);                                                             \
-    v->data = NULL;                                                            \
-    v->size = 0;                                                               \
-    v->cap = 0;                                                                \
+    free(m->ctrl);                                                             \
+    free(m->slots);                                                            \
+    m->ctrl = NULL;                                                            \
+    m->slots = NULL;                                                           \
+    m->size = 0;                                                               \
+    m->cap = 0;                                                                \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_empty(struct NAME * m)                                                  \
+{                                                                              \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(m->cap > 0)                                                             \
+        memset(m->ctrl, GENC_HTABLE_EMPTY, m->cap + GENC_HTABLE_GROUP);        \
+    m->size = 0;                                                               \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_reserve(struct NAME * m, size_t count)                                  \
+{                                                                              \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(count <= m->size) return 0;                                             \
+                                                                               \
+    size_t new_cap = NAME##__cap_for(m, count);                                \
+    if(new_cap == 0) return GENC_ERR_ALLOC_FAIL;                               \
+    if(new_cap <= m->cap) return 0;                                            \
+                                                                               \
+    return NAME##__resize(m, new_cap);                                         \
+}                                                                              \
+                                                                               \
+FN_PREFIX int                                                                  \
+NAME##_rehash(struct NAME * m, size_t count)                                   \
+{                                                                              \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
+                                                                               \
+    if(count < m->size) count = m->size;                                       \
+                                                                               \
+    if(count == 0)                                                             \
+        return NAME##_deinit(m);                                               \
+                                                                               \
+    size_t new_cap = NAME##__cap_for(m, count);                                \
+    if(new_cap == 0) return GENC_ERR_ALLOC_FAIL;                               \
+                                                                               \
+    return NAME##__resize(m, new_cap);                                         \
+}                                                                              \
+                                                                               \
+FN_PREFIX bool                                                                 \
+NAME##_has(struct NAME * m, KEY key)                                           \
+{                                                                              \
+    if(!m) return false;                                                       \
                                                                                \
-    return 0;                                                                  \
+    return NAME##__find(m, key, NAME##__hash(key)) != SIZE_MAX;                \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_ins_many(struct NAME * v, TYPE const * data, size_t count, size_t pos)  \
+NAME##_rm(struct NAME * m, KEY key)                                            \
 {                                                                              \
-    if(!v || (!data && count > 0))                                             \
-        return GENC_ERR_INV_ARG;                                               \
-    if(pos > v->size)                                                          \
-        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    if(count == 0) return 0;                                                   \
+    size_t idx = NAME##__find(m, key, NAME##__hash(key));                      \
+    if(idx == SIZE_MAX) return GENC_ERR_NO_DATA;                               \
                                                                                \
-    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
+    NAME##__erase_at(m, idx);                                                  \
                                                                                \
-    if(count > SIZE_MAX - v->size)                                             \
-        return GENC_ERR_ALLOC_FAIL;                                            \
+    return 0;                                                                  \
+}                                                                              \
                                                                                \
-    size_t req_cap = v->size + count;                                          \
+FN_PREFIX struct NAME##_slot *                                                 \
+NAME##_next(struct NAME * m, size_t* it)                                       \
+{                                                                              \
+    if(!m || !it) return NULL;                                                 \
                                                                                \
-    if(req_cap > v->cap)                                                       \
+    for(; *it < m->cap; ++(*it))                                               \
     {                                                                          \
-        size_t new_cap = (size_t)((double)v->cap * growf_adj);                 \
+        if(!(m->ctrl[*it] & GENC_HTABLE_EMPTY))                                \
+            return &m->slots[(*it)++];                                         \
+    }                                                                          \
                                                                                \
-        if(new_cap < req_cap)                                                  \
-            new_cap = req_cap;                                                 \
+    return NULL;                                                               \
+}                                                                              \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* HASH MAP */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_HMAP_DECLARE() and GENC_HMAP_DEFINE() generate a type-safe hash map
+ * API built on the HASH TABLE engine. GENC_HMAP_INLINE() generates both with
+ * `static inline`.
+ *
+ * Keys and values are stored by value, side by side, in one flat slot array.
+ * Pointers to slots or values are invalidated by any insertion or removal.
+ *
+ * The generated structure must be zero-initialized before its first use.
+ * `max_load` is the load factor that triggers growth; 0 selects
+ * GENC_HTABLE_DEFAULT_LOAD, and other values are clamped to [0.25, 0.95]. It
+ * may be changed at any time and takes effect on the next insertion. */
+
+/* ========================================================================== */
+/* HASH MAP - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>_slot
+{
+    <key> key;
+    <val> val;
+};
+
+|----------------------------------------------------------|
+
+struct <name>
+{
+    uint8_t* ctrl;
+    struct <name>_slot* slots;
+    size_t size;
+    size_t cap;
+    double max_load;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the map and frees allocated memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+
+int <name>_deinit(struct <name>* map);
+
+|----------------------------------------------------------|
+
+* Inserts `key` with `val`, or overwrites the value if `key` is present.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_put(struct <name>* map, <key> key, <val> val);
+
+|----------------------------------------------------------|
+
+* Returns a pointer to the value of `key`.
+
+* RETURN VALUE: Pointer to the value, NULL if `key` is absent or `map` is
+* NULL.
+
+<val>* <name>_get(struct <name>* map, <key> key);
+
+|----------------------------------------------------------|
+
+* Returns whether `key` is present.
+
+bool <name>_has(struct <name>* map, <key> key);
+
+|----------------------------------------------------------|
+
+* Removes `key` and its value.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+* GENC_ERR_NO_DATA: `key` is absent.
+
+int <name>_rm(struct <name>* map, <key> key);
+
+|----------------------------------------------------------|
+
+* Removes all elements while retaining allocated capacity.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+
+int <name>_empty(struct <name>* map);
+
+|----------------------------------------------------------|
+
+* Ensures that `count` elements fit without growing.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_reserve(struct <name>* map, size_t count);
+
+|----------------------------------------------------------|
+
+* Rebuilds the table with the capacity needed for max(`count`, size)
+* elements. This may shrink the table. If both are 0, all allocated storage
+* is freed.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `map` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_rehash(struct <name>* map, size_t count);
+
+|----------------------------------------------------------|
+
+* Iterates over the elements. `*it` must be 0 before the first call.
+
+* RETURN VALUE: Pointer to the next slot, NULL when there are no more
+* elements or `map` or `it` is NULL.
+
+struct <name>_slot* <name>_next(struct <name>* map, size_t* it);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* HASH MAP - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* HASH MAP - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HMAP_DECLARE(NAME, KEY, VAL, FN_PREFIX)                           \
                                                                                \
-        if(new_cap > SIZE_MAX / sizeof(TYPE))                                  \
-            return GENC_ERR_ALLOC_FAIL;                                        \
+struct NAME##_slot                                                             \
+{                                                                              \
+    KEY key;                                                                   \
+    VAL val;                                                                   \
+};                                                                             \
                                                                                \
-        void* new_data = realloc(v->data, new_cap * sizeof(TYPE));             \
-        if(!new_data) return GENC_ERR_ALLOC_FAIL;                              \
+GENC_HTABLE_DECLARE_IMPL(NAME, KEY, FN_PREFIX)                                 \
                                                                                \
-        v->data = new_data;                                                    \
-        v->cap = new_cap;                                                      \
-    }                                                                          \
+FN_PREFIX int                                                                  \
+NAME##_put(struct NAME * m, KEY key, VAL val);                                 \
                                                                                \
-    char* v_data = (char*)v->data;                                             \
+FN_PREFIX VAL *                                                                \
+NAME##_get(struct NAME * m, KEY key);                                          \
+
+/* -------------------------------------------------------------------------- */
+/* HASH MAP - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HMAP_DEFINE(NAME, KEY, VAL, HASH_FN, EQ_FN, FN_PREFIX)            \
                                                                                \
-    if(pos != v->size)                                                         \
-    {                                                                          \
-        memmove(v_data + ((pos + count) * sizeof(TYPE)),                       \
-                v_data + (pos * sizeof(TYPE)),                                 \
-                (v->size - pos) * sizeof(TYPE));                               \
-    }                                                                          \
+GENC_HTABLE_DEFINE_IMPL(NAME, KEY, HASH_FN, EQ_FN, FN_PREFIX)                  \
                                                                                \
-    memmove(v_data + (pos * sizeof(TYPE)), data, count * sizeof(TYPE));        \
+FN_PREFIX int                                                                  \
+NAME##_put(struct NAME * m, KEY key, VAL val)                                  \
+{                                                                              \
+    if(!m) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    v->size += count;                                                          \
+    size_t idx;                                                                \
+    bool found;                                                                \
+                                                                               \
+    int status = NAME##__claim(m, key, &idx, &found);                          \
+    if(status != 0) return status;                                             \
+                                                                               \
+    m->slots[idx].val = val;                                                   \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_pushb_many(struct NAME * v, TYPE const * data, size_t count)            \
+FN_PREFIX VAL *                                                                \
+NAME##_get(struct NAME * m, KEY key)                                           \
+{                                                                              \
+    if(!m) return NULL;                                                        \
+                                                                               \
+    size_t idx = NAME##__find(m, key, NAME##__hash(key));                      \
+                                                                               \
+    return (idx != SIZE_MAX) ? &m->slots[idx].val : NULL;                      \
+}                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* HASH MAP - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HMAP_INLINE(NAME, KEY, VAL, HASH_FN, EQ_FN)                       \
+    GENC_HMAP_DECLARE(NAME, KEY, VAL, static inline)                           \
+    GENC_HMAP_DEFINE(NAME, KEY, VAL, HASH_FN, EQ_FN, static inline)            \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* HASH SET */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_HSET_DECLARE() and GENC_HSET_DEFINE() generate a type-safe hash set
+ * API built on the HASH TABLE engine. GENC_HSET_INLINE() generates both with
+ * `static inline`.
+ *
+ * Slots hold only the key. The structure, `max_load` and iteration behave as
+ * described for GENC_HMAP. */
+
+/* ========================================================================== */
+/* HASH SET - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>_slot
+{
+    <key> key;
+};
+
+|----------------------------------------------------------|
+
+struct <name>
+{
+    uint8_t* ctrl;
+    struct <name>_slot* slots;
+    size_t size;
+    size_t cap;
+    double max_load;
+};
+
+|----------------------------------------------------------|
+
+* Deinitializes the set and frees allocated memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `set` is NULL.
+
+int <name>_deinit(struct <name>* set);
+
+|----------------------------------------------------------|
+
+* Inserts `key`. Inserting a present key has no effect.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `set` is NULL.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_ins(struct <name>* set, <key> key);
+
+|----------------------------------------------------------|
+
+* Inserts `count` keys from `keys`. If `added` is not NULL, `added[i]` is set
+* to whether `keys[i]` was newly inserted; a key repeated within `keys` is
+* reported as new only once. On failure, the keys before the failing one
+* remain inserted.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `set` is NULL, or `keys` is NULL when `count` is nonzero.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_ins_many(struct <name>* set, <key> const* keys, size_t count,
+                    bool* added);
+
+|----------------------------------------------------------|
+
+* Returns whether `key` is present.
+
+bool <name>_has(struct <name>* set, <key> key);
+
+|----------------------------------------------------------|
+
+* Sets `out[i]` to whether `keys[i]` is present, for `count` keys.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `set` is NULL, or `keys` or `out` is NULL when `count` is
+* nonzero.
+
+int <name>_has_many(struct <name>* set, <key> const* keys, size_t count,
+                    bool* out);
+
+|----------------------------------------------------------|
+
+* Removes `key`.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `set` is NULL.
+* GENC_ERR_NO_DATA: `key` is absent.
+
+int <name>_rm(struct <name>* set, <key> key);
+
+|----------------------------------------------------------|
+
+* Stores the union of `a` and `b` into `out`. `out` must be initialized and
+* distinct from `a` and `b`; its previous elements are removed, but its
+* capacity is reused.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `out`, `a` or `b` is NULL, or `out` is `a` or `b`.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_union(struct <name>* out, struct <name>* a, struct <name>* b);
+
+|----------------------------------------------------------|
+
+* Stores the intersection of `a` and `b` into `out`. The requirements on
+* `out` are the same as for <name>_union().
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `out`, `a` or `b` is NULL, or `out` is `a` or `b`.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the required capacity
+* cannot be represented.
+
+int <name>_intersect(struct <name>* out, struct <name>* a, struct <name>* b);
+
+|----------------------------------------------------------|
+
+* <name>_empty(), <name>_reserve(), <name>_rehash() and <name>_next() behave
+* as their GENC_HMAP counterparts.
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* HASH SET - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* HASH SET - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HSET_DECLARE(NAME, KEY, FN_PREFIX)                                \
+                                                                               \
+struct NAME##_slot                                                             \
 {                                                                              \
-    if(!v || (!data && count > 0))                                             \
-        return GENC_ERR_INV_ARG;                                               \
+    KEY key;                                                                   \
+};                                                                             \
                                                                                \
-    int status = NAME##_ins_many(v, data, count, v->size);                     \
-    switch(status)                                                             \
-    {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        case GENC_ERR_ALLOC_FAIL:                                              \
-            return GENC_ERR_ALLOC_FAIL;                                        \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
-    }                                                                          \
-}                                                                              \
+GENC_HTABLE_DECLARE_IMPL(NAME, KEY, FN_PREFIX)                                 \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_rm_at_many(struct NAME * v, size_t pos, size_t count)                   \
-{                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if((pos > v->size) || (count > v->size - pos))                             \
-        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+NAME##_ins(struct NAME * s, KEY key);                                          \
                                                                                \
-    if(count == 0) return 0;                                                   \
+FN_PREFIX int                                                                  \
+NAME##_ins_many(struct NAME * s, KEY const * keys, size_t count,               \
+                bool* added);                                                  \
                                                                                \
-    char* v_data = (char*)v->data;                                             \
+FN_PREFIX int                                                                  \
+NAME##_has_many(struct NAME * s, KEY const * keys, size_t count,               \
+                bool* out);                                                    \
                                                                                \
-    memmove(v_data + (pos * sizeof(TYPE)),                                     \
-            v_data + ((pos + count) * sizeof(TYPE)),                           \
-            (v->size - pos - count) * sizeof(TYPE));                           \
+FN_PREFIX int                                                                  \
+NAME##_union(struct NAME * out, struct NAME * a, struct NAME * b);             \
                                                                                \
-    v->size -= count;                                                          \
+FN_PREFIX int                                                                  \
+NAME##_intersect(struct NAME * out, struct NAME * a, struct NAME * b);         \
+
+/* -------------------------------------------------------------------------- */
+/* HASH SET - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HSET_DEFINE(NAME, KEY, HASH_FN, EQ_FN, FN_PREFIX)                 \
                                                                                \
-    return 0;                                                                  \
-}                                                                              \
+GENC_HTABLE_DEFINE_IMPL(NAME, KEY, HASH_FN, EQ_FN, FN_PREFIX)                  \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_shrink(struct NAME * v)                                                 \
+NAME##_ins(struct NAME * s, KEY key)                                           \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(!s) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    if(v->size == 0)                                                           \
-    {                                                                          \
-        free(v->data);                                                         \
-        v->data = NULL;                                                        \
-        v->cap = 0;                                                            \
+    size_t idx;                                                                \
+    bool found;                                                                \
                                                                                \
-        return 0;                                                              \
-    }                                                                          \
+    return NAME##__claim(s, key, &idx, &found);                                \
+}                                                                              \
                                                                                \
-    double growf_adj = ((GROWF) > 1.1 ? (GROWF) : 1.1);                        \
-    size_t threshold = (size_t)((double)v->cap / growf_adj / growf_adj);       \
+FN_PREFIX int                                                                  \
+NAME##_ins_many(struct NAME * s, KEY const * keys, size_t count,               \
+                bool* added)                                                   \
+{                                                                              \
+    if(!s || (!keys && (count > 0))) return GENC_ERR_INV_ARG;                  \
                                                                                \
-    if(v->size < threshold)                                                    \
+    size_t i;                                                                  \
+    for(i = 0; i < count; i++)                                                 \
     {                                                                          \
-        size_t new_cap = (size_t)((double)v->size * growf_adj);                \
-        if(new_cap < v->size) new_cap = v->size;                               \
+        size_t idx;                                                            \
+        bool found;                                                            \
                                                                                \
-        void* new_data = realloc(v->data, new_cap * sizeof(TYPE));             \
-        if(!new_data) return 0;                                                \
+        int status = NAME##__claim(s, keys[i], &idx, &found);                  \
+        if(status != 0) return status;                                         \
                                                                                \
-        v->data = new_data;                                                    \
-        v->cap = new_cap;                                                      \
+        if(added) added[i] = !found;                                           \
     }                                                                          \
-    return 0;                                                                  \
                                                                                \
+    return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb_many(struct NAME * v, size_t count)                                \
+NAME##_has_many(struct NAME * s, KEY const * keys, size_t count,               \
+                bool* out)                                                     \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if(count > v->size) return GENC_ERR_OUT_OF_BOUNDS;                         \
+    if(!s || ((!keys || !out) && (count > 0))) return GENC_ERR_INV_ARG;        \
                                                                                \
-    if(count == 0) return 0;                                                   \
+    size_t i;                                                                  \
+    for(i = 0; i < count; i++)                                                 \
+        out[i] = NAME##_has(s, keys[i]);                                       \
                                                                                \
-    int status = NAME##_rm_at_many(v, v->size - count, count);                 \
-    switch(status)                                                             \
-    {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
-    }                                                                          \
+    return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_rm_at_many_shrink(struct NAME * v, size_t pos, size_t count)            \
+NAME##_union(struct NAME * out, struct NAME * a, struct NAME * b)              \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if((pos > v->size) || (count > v->size - pos))                             \
-        return GENC_ERR_OUT_OF_BOUNDS;                                         \
+    if(!out || !a || !b || (out == a) || (out == b))                           \
+        return GENC_ERR_INV_ARG;                                               \
                                                                                \
-    if(count == 0) return 0;                                                   \
+    NAME##_empty(out);                                                         \
                                                                                \
-    int status = NAME##_rm_at_many(v, pos, count);                             \
-    if(status != 0) return GENC_ERR_UNEXPECTED;                                \
+    size_t bound = (a->size > SIZE_MAX - b->size) ?                            \
+        SIZE_MAX : a->size + b->size;                                          \
                                                                                \
-    status = NAME##_shrink(v);                                                 \
-    switch(status)                                                             \
+    int status = NAME##_reserve(out, bound);                                   \
+    if(status != 0) return status;                                             \
+                                                                               \
+    struct NAME * srcs[2] = { a, b };                                          \
+                                                                               \
+    size_t i, j;                                                               \
+    for(i = 0; i < 2; i++)                                                     \
     {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
+        for(j = 0; j < srcs[i]->cap; j++)                                      \
+        {                                                                      \
+            if(srcs[i]->ctrl[j] & GENC_HTABLE_EMPTY) continue;                 \
+                                                                               \
+            status = NAME##_ins(out, srcs[i]->slots[j].key);                   \
+            if(status != 0) return status;                                     \
+        }                                                                      \
     }                                                                          \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb_many_shrink(struct NAME * v, size_t count)                         \
+NAME##_intersect(struct NAME * out, struct NAME * a, struct NAME * b)          \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if(count > v->size) return GENC_ERR_OUT_OF_BOUNDS;                         \
+    if(!out || !a || !b || (out == a) || (out == b))                           \
+        return GENC_ERR_INV_ARG;                                               \
                                                                                \
-    if(count == 0) return 0;                                                   \
+    NAME##_empty(out);                                                         \
                                                                                \
-    int status = NAME##_rm_at_many_shrink(v, v->size - count, count);          \
-    switch(status)                                                             \
+    /* Walk the smaller set and probe the larger one. */                       \
+    if(a->size > b->size)                                                      \
     {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
+        struct NAME * tmp = a;                                                 \
+        a = b;                                                                 \
+        b = tmp;                                                               \
     }                                                                          \
-}                                                                              \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_ins(struct NAME * v, TYPE data, size_t pos)                             \
-{                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if(pos > v->size) return GENC_ERR_OUT_OF_BOUNDS;                           \
+    int status = NAME##_reserve(out, a->size);                                 \
+    if(status != 0) return status;                                             \
                                                                                \
-    int status = NAME##_ins_many(v, &data, 1, pos);                            \
-    switch(status)                                                             \
+    size_t i;                                                                  \
+    for(i = 0; i < a->cap; i++)                                                \
     {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        case GENC_ERR_ALLOC_FAIL:                                              \
-            return GENC_ERR_ALLOC_FAIL;                                        \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
+        if(a->ctrl[i] & GENC_HTABLE_EMPTY) continue;                           \
+        if(!NAME##_has(b, a->slots[i].key)) continue;                          \
+                                                                               \
+        status = NAME##_ins(out, a->slots[i].key);                             \
+        if(status != 0) return status;                                         \
     }                                                                          \
+                                                                               \
+    return 0;                                                                  \
 }                                                                              \
+
+/* -------------------------------------------------------------------------- */
+/* HASH SET - INLINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_HSET_INLINE(NAME, KEY, HASH_FN, EQ_FN)                            \
+    GENC_HSET_DECLARE(NAME, KEY, static inline)                                \
+    GENC_HSET_DEFINE(NAME, KEY, HASH_FN, EQ_FN, static inline)                 \
+
+/* ========================================================================== */
+/* -------------------------------------------------------------------------- */
+/* SPSC QUEUE */
+/* -------------------------------------------------------------------------- */
+/* ========================================================================== */
+
+/* GENC_SPSC_QUEUE_DECLARE() and GENC_SPSC_QUEUE_DEFINE() generate a type-safe
+ * bounded single-producer/single-consumer queue API. GENC_SPSC_QUEUE_INLINE()
+ * generates both with `static inline`. Available only with C11 atomics
+ * (GENC_HAS_ATOMICS).
+ *
+ * One thread may push while another thread pops, concurrently and without
+ * locks. Every operation completes in a bounded number of steps on both
+ * sides (wait-free). The producer and consumer indices live on separate cache
+ * lines of GENC_CACHE_LINE_SIZE bytes, each next to a cached copy of the other
+ * side's index, so the shared lines are only touched when the cached view
+ * says the queue is full or empty.
+ *
+ * The queue must be initialized with <name>_init(). Init and deinit must not
+ * run concurrently with any other operation. */
+
+#ifdef GENC_HAS_ATOMICS
+
+/* ========================================================================== */
+/* SPSC QUEUE - PROTOTYPES */
+/* ========================================================================== */
+
+/* --------------------------------------------------------|
+
+struct <name>
+{
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t head;
+    size_t tail_cache;
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t tail;
+    size_t head_cache;
+    _Alignas(GENC_CACHE_LINE_SIZE) <type>* data;
+    size_t cap;
+};
+
+|----------------------------------------------------------|
+
+* Initializes the queue with room for at least `cap` elements. The capacity
+* is rounded up to a power of two.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `queue` is NULL or `cap` is 0.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
+
+int <name>_init(struct <name>* queue, size_t cap);
+
+|----------------------------------------------------------|
+
+* Deinitializes the queue and frees allocated memory.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `queue` is NULL.
+
+int <name>_deinit(struct <name>* queue);
+
+|----------------------------------------------------------|
+
+* Enqueues an element. Producer only.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `queue` is NULL.
+* GENC_ERR_FULL: The queue is full.
+
+int <name>_push(struct <name>* queue, <type> data);
+
+|----------------------------------------------------------|
+
+* Dequeues an element. If `out` is non-NULL, the element is copied to it.
+* Consumer only.
+
+* RETURN VALUE: 0 on success, error code on failure.
+
+* ERROR CODES:
+* GENC_ERR_INV_ARG: `queue` is NULL.
+* GENC_ERR_NO_DATA: The queue is empty.
+
+int <name>_pop(struct <name>* queue, <type>* out);
+
+|----------------------------------------------------------|
+
+* Enqueues up to `count` elements from `data`, in order, and publishes them
+* all at once. Producer only.
+
+* RETURN VALUE: The number of elements enqueued. 0 if `queue` or `data` is
+* NULL.
+
+size_t <name>_push_many(struct <name>* queue, <type> const* data,
+                        size_t count);
+
+|----------------------------------------------------------|
+
+* Dequeues up to `count` elements into `out`, in order. If `out` is NULL,
+* the elements are discarded. Consumer only.
+
+* RETURN VALUE: The number of elements dequeued. 0 if `queue` is NULL.
+
+size_t <name>_pop_many(struct <name>* queue, <type>* out, size_t count);
+
+|----------------------------------------------------------|
+
+* Returns the number of queued elements. When called concurrently with
+* push or pop, the result is a snapshot that may already be stale.
+
+size_t <name>_size(struct <name>* queue);
+
+|-------------------------------------------------------- */
+
+/* ========================================================================== */
+/* SPSC QUEUE - GENERATOR MACROS */
+/* ========================================================================== */
+
+/* -------------------------------------------------------------------------- */
+/* SPSC QUEUE - DECLARE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SPSC_QUEUE_DECLARE(NAME, TYPE, FN_PREFIX)                         \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_pushb(struct NAME * v, TYPE data)                                       \
+struct NAME                                                                    \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t head;                         \
+    size_t tail_cache;                                                         \
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t tail;                         \
+    size_t head_cache;                                                         \
+    _Alignas(GENC_CACHE_LINE_SIZE) TYPE * data;                                \
+    size_t cap;                                                                \
+};                                                                             \
                                                                                \
-    int status = NAME##_pushb_many(v, &data, 1);                               \
-    switch(status)                                                             \
-    {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        case GENC_ERR_ALLOC_FAIL:                                              \
-            return GENC_ERR_ALLOC_FAIL;                                        \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
-    }                                                                          \
-}                                                                              \
+FN_PREFIX int                                                                  \
+NAME##_init(struct NAME * q, size_t cap);                                      \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_rm_at(struct NAME * v, size_t pos)                                      \
-{                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+NAME##_deinit(struct NAME * q);                                                \
                                                                                \
-    int status = NAME##_rm_at_many(v, pos, 1);                                 \
-    switch(status)                                                             \
-    {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
-    }                                                                          \
-}                                                                              \
+FN_PREFIX int                                                                  \
+NAME##_push(struct NAME * q, TYPE data);                                       \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb(struct NAME * v)                                                   \
-{                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+NAME##_pop(struct NAME * q, TYPE * out);                                       \
                                                                                \
-    int status = NAME##_popb_many(v, 1);                                       \
-    switch(status)                                                             \
-    {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
-    }                                                                          \
-}                                                                              \
+FN_PREFIX size_t                                                               \
+NAME##_push_many(struct NAME * q, TYPE const * data, size_t count);            \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_pop_many(struct NAME * q, TYPE * out, size_t count);                    \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_size(struct NAME * q);                                                  \
+
+/* -------------------------------------------------------------------------- */
+/* SPSC QUEUE - DEFINE */
+/* -------------------------------------------------------------------------- */
+
+#define GENC_SPSC_QUEUE_DEFINE(NAME, TYPE, FN_PREFIX)                          \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_rm_at_shrink(struct NAME * v, size_t pos)                               \
+NAME##_init(struct NAME * q, size_t cap)                                       \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if(pos >= v->size) return GENC_ERR_OUT_OF_BOUNDS;                          \
+    if(!q || (cap == 0)) return GENC_ERR_INV_ARG;                              \
                                                                                \
-    int status = NAME##_rm_at_many_shrink(v, pos, 1);                          \
-    switch(status)                                                             \
-    {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
-    }                                                                          \
+    cap = genc_pow2_ceil(cap);                                                 \
+    if((cap == 0) || (cap > SIZE_MAX / sizeof(TYPE)))                          \
+        return GENC_ERR_ALLOC_FAIL;                                            \
+                                                                               \
+    q->data = malloc(cap * sizeof(TYPE));                                      \
+    if(!q->data) return GENC_ERR_ALLOC_FAIL;                                   \
+                                                                               \
+    q->cap = cap;                                                              \
+    q->tail_cache = 0;                                                         \
+    q->head_cache = 0;                                                         \
+    atomic_init(&q->head, 0);                                                  \
+    atomic_init(&q->tail, 0);                                                  \
+                                                                               \
+    return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb_shrink(struct NAME * v)                                            \
+NAME##_deinit(struct NAME * q)                                                 \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
-    if(v->size == 0) return GENC_ERR_NO_DATA;                                  \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    int status = NAME##_popb_many_shrink(v, 1);                                \
-    switch(status)                                                             \
-    {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
-    }                                                                          \
+    free(q->data);                                                             \
+    q->data = NULL;                                                            \
+    q->cap = 0;                                                                \
+    q->tail_cache = 0;                                                         \
+    q->head_cache = 0;                                                         \
+    atomic_store_explicit(&q->head, 0, memory_order_relaxed);                  \
+    atomic_store_explicit(&q->tail, 0, memory_order_relaxed);                  \
+                                                                               \
+    return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty(struct NAME * v)                                                  \
+NAME##_push(struct NAME * q, TYPE data)                                        \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    v->size = 0;                                                               \
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);        \
+                                                                               \
+    if(tail - q->head_cache == q->cap)                                         \
+    {                                                                          \
+        q->head_cache = atomic_load_explicit(&q->head,                         \
+                                             memory_order_acquire);            \
+        if(tail - q->head_cache == q->cap)                                     \
+            return GENC_ERR_FULL;                                              \
+    }                                                                          \
+                                                                               \
+    q->data[tail & (q->cap - 1)] = data;                                       \
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);           \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty_shrink(struct NAME * v)                                           \
+NAME##_pop(struct NAME * q, TYPE * out)                                        \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    free(v->data);                                                             \
-    v->data = NULL;                                                            \
-    v->cap = 0;                                                                \
-    v->size = 0;                                                               \
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);        \
+                                                                               \
+    if(head == q->tail_cache)                                                  \
+    {                                                                          \
+        q->tail_cache = atomic_load_explicit(&q->tail,                         \
+                                             memory_order_acquire);            \
+        if(head == q->tail_cache)                                              \
+            return GENC_ERR_NO_DATA;                                           \
+    }                                                                          \
+                                                                               \
+    if(out) *out = q->data[head & (q->cap - 1)];                               \
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);           \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_fit(struct NAME * v)                                                    \
+FN_PREFIX size_t                                                               \
+NAME##_push_many(struct NAME * q, TYPE const * data, size_t count)             \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(!q || !data) return 0;                                                  \
                                                                                \
-    if(v->size == v->cap) return 0;                                            \
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);        \
+    size_t free_slots = q->cap - (tail - q->head_cache);                       \
                                                                                \
-    if(v->size == 0)                                                           \
+    if(free_slots < count)                                                     \
     {                                                                          \
-        free(v->data);                                                         \
-        v->data = NULL;                                                        \
-        v->cap = 0;                                                            \
-        return 0;                                                              \
+        q->head_cache = atomic_load_explicit(&q->head,                         \
+                                             memory_order_acquire);            \
+        free_slots = q->cap - (tail - q->head_cache);                          \
     }                                                                          \
                                                                                \
-    void* new_data = realloc(v->data, v->size * sizeof(TYPE));                 \
-    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+    if(count > free_slots) count = free_slots;                                 \
+    if(count == 0) return 0;                                                   \
                                                                                \
-    v->data = new_data;                                                        \
-    v->cap = v->size;                                                          \
+    size_t pos = tail & (q->cap - 1);                                          \
+    size_t first = q->cap - pos;                                               \
+    if(first > count) first = count;                                           \
                                                                                \
-    return 0;                                                                  \
+    memcpy(q->data + pos, data, first * sizeof(TYPE));                         \
+    memcpy(q->data, data + first, (count - first) * sizeof(TYPE));             \
+                                                                               \
+    atomic_store_explicit(&q->tail, tail + count, memory_order_release);       \
+                                                                               \
+    return count;                                                              \
 }                                                                              \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_prealloc(struct NAME * v, size_t size)                                  \
+FN_PREFIX size_t                                                               \
+NAME##_pop_many(struct NAME * q, TYPE * out, size_t count)                     \
 {                                                                              \
-    if(!v) return GENC_ERR_INV_ARG;                                            \
+    if(!q) return 0;                                                           \
                                                                                \
-    if(size == 0) return 0;                                                    \
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);        \
+    size_t avail = q->tail_cache - head;                                       \
                                                                                \
-    if(size > SIZE_MAX - v->cap)                                               \
-        return GENC_ERR_ALLOC_FAIL;                                            \
+    if(avail < count)                                                          \
+    {                                                                          \
+        q->tail_cache = atomic_load_explicit(&q->tail,                         \
+                                             memory_order_acquire);            \
+        avail = q->tail_cache - head;                                          \
+    }                                                                          \
                                                                                \
-    size_t new_cap = v->cap + size;                                            \
-    if(new_cap > SIZE_MAX / sizeof(TYPE))                                      \
-        return GENC_ERR_ALLOC_FAIL;                                            \
+    if(count > avail) count = avail;                                           \
+    if(count == 0) return 0;                                                   \
                                                                                \
-    void* new_data = realloc(v->data, new_cap * sizeof(TYPE));                 \
-    if(!new_data) return GENC_ERR_ALLOC_FAIL;                                  \
+    if(out)                                                                    \
+    {                                                                          \
+        size_t pos = head & (q->cap - 1);                                      \
+        size_t first = q->cap - pos;                                           \
+        if(first > count) first = count;                                       \
                                                                                \
-    v->data = new_data;                                                        \
-    v->cap = new_cap;                                                          \
+        memcpy(out, q->data + pos, first * sizeof(TYPE));                      \
+        memcpy(out + first, q->data, (count - first) * sizeof(TYPE));          \
+    }                                                                          \
                                                                                \
-    return 0;                                                                  \
-}
+    atomic_store_explicit(&q->head, head + count, memory_order_release);       \
+                                                                               \
+    return count;                                                              \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_size(struct NAME * q)                                                   \
+{                                                                              \
+    if(!q) return 0;                                                           \
+                                                                               \
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);        \
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);        \
+                                                                               \
+    return tail - head;                                                        \
+}                                                                              \
 
 /* -------------------------------------------------------------------------- */
-/* VECTOR - INLINE */
+/* SPSC QUEUE - INLINE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_VECTOR_INLINE(NAME, TYPE, GROWF)                                  \
-    GENC_VECTOR_DECLARE(NAME, TYPE, static inline)                             \
-    GENC_VECTOR_DEFINE(NAME, TYPE, GROWF, static inline)
+#define GENC_SPSC_QUEUE_INLINE(NAME, TYPE)                                     \
+    GENC_SPSC_QUEUE_DECLARE(NAME, TYPE, static inline)                         \
+    GENC_SPSC_QUEUE_DEFINE(NAME, TYPE, static inline)                          \
+
+#endif // GENC_HAS_ATOMICS
 
 /* ========================================================================== */
 /* -------------------------------------------------------------------------- */
-/* LIST */
+/* MPMC QUEUE */
 /* -------------------------------------------------------------------------- */
 /* ========================================================================== */
 
-/* GENC_LIST_DECLARE() and GENC_LIST_DEFINE() generate a type-safe doubly-linked
- * list API. GENC_LIST_INLINE() generates both with `static inline`.
+/* GENC_MPMC_QUEUE_DECLARE() and GENC_MPMC_QUEUE_DEFINE() generate a type-safe
+ * bounded multi-producer/multi-consumer queue API. GENC_MPMC_QUEUE_INLINE()
+ * generates both with `static inline`. Available only with C11 atomics
+ * (GENC_HAS_ATOMICS).
  *
- * The generated structure must be zero-initialized before its first use. */
+ * The queue is an array of cells, each tagged with a sequence number that
+ * tells producers and consumers whether the cell is free or full for the
+ * current lap (D. Vyukov's bounded MPMC queue). Producers only contend on the
+ * enqueue index and consumers only on the dequeue index; the two live on
+ * separate cache lines. No locks are taken.
+ *
+ * The try_* operations fail immediately when the queue is full or empty. The
+ * blocking operations retry, executing GENC_SPIN_YIELD() between attempts.
+ *
+ * The queue must be initialized with <name>_init(). Init and deinit must not
+ * run concurrently with any other operation. */
+
+#ifdef GENC_HAS_ATOMICS
 
 /* ========================================================================== */
-/* LIST - PROTOTYPES */
+/* MPMC QUEUE - PROTOTYPES */
 /* ========================================================================== */
 
 /* --------------------------------------------------------|
 
-struct <name>_node
+struct <name>_cell
 {
+    atomic_size_t seq;
     <type> data;
-    struct <name>_node *next, *prev;
 };
 
 |----------------------------------------------------------|
 
 struct <name>
 {
-    struct <name>_node *head, *tail;
-    size_t size;
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t enq_pos;
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t deq_pos;
+    _Alignas(GENC_CACHE_LINE_SIZE) struct <name>_cell* cells;
+    size_t cap;
 };
 
 |----------------------------------------------------------|
 
-* Deinitializes the list and frees all nodes.
+* Initializes the queue with room for at least `cap` elements. The capacity
+* is rounded up to a power of two, and is at least 2.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_INV_ARG: `queue` is NULL or `cap` is 0.
+* GENC_ERR_ALLOC_FAIL: Memory allocation failed or the requested capacity
+* cannot be represented.
 
-int <name>_deinit(struct <name>* list);
+int <name>_init(struct <name>* queue, size_t cap);
 
 |----------------------------------------------------------|
 
-* Appends an element to the list.
+* Deinitializes the queue and frees allocated memory.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+* GENC_ERR_INV_ARG: `queue` is NULL.
 
-int <name>_pushb(struct <name>* list, <type> data);
+int <name>_deinit(struct <name>* queue);
 
 |----------------------------------------------------------|
 
-* Prepends an element to the list.
+* Enqueues an element if the queue is not full.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+* GENC_ERR_INV_ARG: `queue` is NULL.
+* GENC_ERR_FULL: The queue is full.
 
-int <name>_pushf(struct <name>* list, <type> data);
+int <name>_try_push(struct <name>* queue, <type> data);
 
 |----------------------------------------------------------|
 
-* Removes the last element from the list.
+* Dequeues an element if the queue is not empty. If `out` is non-NULL, the
+* element is copied to it.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
-* GENC_ERR_NO_DATA: The list is empty.
+* GENC_ERR_INV_ARG: `queue` is NULL.
+* GENC_ERR_NO_DATA: The queue is empty.
 
-int <name>_popb(struct <name>* list);
+int <name>_try_pop(struct <name>* queue, <type>* out);
 
 |----------------------------------------------------------|
 
-* Removes the first element from the list.
+* Enqueues an element, waiting for a free cell if the queue is full.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
-* GENC_ERR_NO_DATA: The list is empty.
+* GENC_ERR_INV_ARG: `queue` is NULL.
 
-int <name>_popf(struct <name>* list);
+int <name>_push(struct <name>* queue, <type> data);
 
 |----------------------------------------------------------|
 
-* Removes all elements and frees all nodes.
+* Dequeues an element, waiting for one if the queue is empty. If `out` is
+* non-NULL, the element is copied to it.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_INV_ARG: `queue` is NULL.
 
-int <name>_empty(struct <name>* list);
+int <name>_pop(struct <name>* queue, <type>* out);
 
 |----------------------------------------------------------|
 
-* Inserts an element after `node`, or at the front if `node` is NULL.
-* If non-NULL, `node` must belong to `list`.
-
-* RETURN VALUE: 0 on success, error code on failure.
+* Enqueues up to `count` elements from `data` as one contiguous run, claimed
+* with a single update of the enqueue index. Does not wait.
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+* RETURN VALUE: The number of elements enqueued. 0 if `queue` or `data` is
+* NULL.
 
-int <name>_ins_after(struct <name>* list, <type> data,
-                      struct <name>_node* node);
+size_t <name>_push_many(struct <name>* queue, <type> const* data,
+                        size_t count);
 
 |----------------------------------------------------------|
 
-* Inserts an element before `node`. `node` must belong to `list`.
-
-* RETURN VALUE: 0 on success, error code on failure.
+* Dequeues up to `count` contiguous elements into `out`, claimed with a
+* single update of the dequeue index. If `out` is NULL, the elements are
+* discarded. Does not wait.
 
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `list` or `node` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+* RETURN VALUE: The number of elements dequeued. 0 if `queue` is NULL.
 
-int <name>_ins_before(struct <name>* list, <type> data,
-                       struct <name>_node* node);
+size_t <name>_pop_many(struct <name>* queue, <type>* out, size_t count);
 
 |----------------------------------------------------------|
 
-* Removes `node` from the list and frees it. `node` must belong to `list`.
-
-* RETURN VALUE: 0 on success, error code on failure.
-
-* ERROR CODES:
-* GENC_ERR_INV_ARG: `list` or `node` is NULL.
+* Returns the number of queued elements. When called concurrently with
+* push or pop, the result is a snapshot that may already be stale.
 
-int <name>_rm(struct <name>* list, struct <name>_node* node);
+size_t <name>_size(struct <name>* queue);
 
 |-------------------------------------------------------- */
 
 /* ========================================================================== */
-/* LIST - GENERATOR MACROS */
+/* MPMC QUEUE - GENERATOR MACROS */
 /* ========================================================================== */
 
 /* -------------------------------------------------------------------------- */
-/* LIST - DECLARE */
+/* MPMC QUEUE - DECLARE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_LIST_DECLARE(NAME, TYPE, FN_PREFIX)                               \
+#define GENC_MPMC_QUEUE_DECLARE(NAME, TYPE, FN_PREFIX)                         \
                                                                                \
-struct NAME                                                                    \
+struct NAME##_cell                                                             \
 {                                                                              \
-    struct NAME##_node *head, *tail;                                           \
-    size_t size;                                                               \
+    atomic_size_t seq;                                                         \
+    TYPE data;                                                                 \
 };                                                                             \
                                                                                \
-struct NAME##_node                                                             \
+struct NAME                                                                    \
 {                                                                              \
-    TYPE data;                                                                 \
-    struct NAME##_node *next, *prev;                                           \
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t enq_pos;                      \
+    _Alignas(GENC_CACHE_LINE_SIZE) atomic_size_t deq_pos;                      \
+    _Alignas(GENC_CACHE_LINE_SIZE) struct NAME##_cell * cells;                 \
+    size_t cap;                                                                \
 };                                                                             \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_deinit(struct NAME * l);                                                \
+NAME##_init(struct NAME * q, size_t cap);                                      \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushb(struct NAME * l, TYPE data);                                      \
+NAME##_deinit(struct NAME * q);                                                \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushf(struct NAME * l, TYPE data);                                      \
+NAME##_try_push(struct NAME * q, TYPE data);                                   \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popf(struct NAME * l);                                                  \
+NAME##_try_pop(struct NAME * q, TYPE * out);                                   \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb(struct NAME * l);                                                  \
+NAME##_push(struct NAME * q, TYPE data);                                       \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty(struct NAME * l);                                                 \
+NAME##_pop(struct NAME * q, TYPE * out);                                       \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_ins_after(struct NAME * l, TYPE data, struct NAME##_node* n);           \
+FN_PREFIX size_t                                                               \
+NAME##_push_many(struct NAME * q, TYPE const * data, size_t count);            \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_ins_before(struct NAME * l, TYPE data, struct NAME##_node* n);          \
+FN_PREFIX size_t                                                               \
+NAME##_pop_many(struct NAME * q, TYPE * out, size_t count);                    \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_rm(struct NAME * l, struct NAME##_node* n);                             \
+FN_PREFIX size_t                                                               \
+NAME##_size(struct NAME * q);                                                  \
 
 /* -------------------------------------------------------------------------- */
-/* LIST - DEFINE */
+/* MPMC QUEUE - DEFINE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_LIST_DEFINE(NAME, TYPE, FN_PREFIX)                                \
-                                                                               \
-FN_PREFIX int                                                                  \
-NAME##_deinit(struct NAME * l)                                                 \
-{                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
-                                                                               \
-    struct NAME##_node* it = l->head;                                          \
-    struct NAME##_node* next;                                                  \
-    while(it)                                                                  \
-    {                                                                          \
-        next = it->next;                                                       \
-        free(it);                                                              \
-        it = next;                                                             \
-    }                                                                          \
-                                                                               \
-    l->size = 0;                                                               \
-    l->head = NULL;                                                            \
-    l->tail = NULL;                                                            \
-                                                                               \
-    return 0;                                                                  \
-}                                                                              \
-                                                                               \
-FN_PREFIX int                                                                  \
-NAME##_pushb(struct NAME * l, TYPE data)                                       \
-{                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
-                                                                               \
-    struct NAME##_node* node = malloc(sizeof(struct NAME##_node));             \
-    if(node == NULL) return GENC_ERR_ALLOC_FAIL;                               \
-                                                                               \
-    node->data = data;                                                         \
-    node->next = NULL;                                                         \
-    node->prev = NULL;                                                         \
-                                                                               \
-    if(l->size == 0)                                                           \
-    {                                                                          \
-        l->head = node;                                                        \
-        l->tail = node;                                                        \
-    }                                                                          \
-    else                                                                       \
-    {                                                                          \
-        l->tail->next = node;                                                  \
-        node->prev = l->tail;                                                  \
-        l->tail = node;                                                        \
-    }                                                                          \
-                                                                               \
-    ++(l->size);                                                               \
-                                                                               \
-    return 0;                                                                  \
-}                                                                              \
+#define GENC_MPMC_QUEUE_DEFINE(NAME, TYPE, FN_PREFIX)                          \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushf(struct NAME * l, TYPE data)                                       \
+NAME##_init(struct NAME * q, size_t cap)                                       \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
-                                                                               \
-    struct NAME##_node* node = malloc(sizeof(struct NAME##_node));             \
-    if(node == NULL) return GENC_ERR_ALLOC_FAIL;                               \
-                                                                               \
-    node->data = data;                                                         \
-    node->prev = NULL;                                                         \
-    node->next = NULL;                                                         \
-                                                                               \
-    if(l->size == 0)                                                           \
-    {                                                                          \
-        l->head = node;                                                        \
-        l->tail = node;                                                        \
-    }                                                                          \
-    else                                                                       \
-    {                                                                          \
-        l->head->prev = node;                                                  \
-        node->next = l->head;                                                  \
-        l->head = node;                                                        \
-    }                                                                          \
-                                                                               \
-    ++(l->size);                                                               \
+    if(!q || (cap == 0)) return GENC_ERR_INV_ARG;                              \
                                                                                \
-    return 0;                                                                  \
-}                                                                              \
+    if(cap < 2) cap = 2;                                                       \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_popf(struct NAME * l)                                                   \
-{                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
-    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
+    cap = genc_pow2_ceil(cap);                                                 \
+    if((cap == 0) || (cap > SIZE_MAX / sizeof(struct NAME##_cell)))            \
+        return GENC_ERR_ALLOC_FAIL;                                            \
                                                                                \
-    if(l->size == 1)                                                           \
-    {                                                                          \
-        free(l->head);                                                         \
-        l->head = NULL;                                                        \
-        l->tail = NULL;                                                        \
-    }                                                                          \
-    else                                                                       \
-    {                                                                          \
-        struct NAME##_node* old_head = l->head;                                \
-        l->head = l->head->next;                                               \
-        l->head->prev = NULL;                                                  \
-        free(old_head);                                                        \
-    }                                                                          \
+    q->cells = malloc(cap * sizeof(struct NAME##_cell));                       \
+    if(!q->cells) return GENC_ERR_ALLOC_FAIL;                                  \
                                                                                \
-    --(l->size);                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < cap; i++)                                                   \
+        atomic_init(&q->cells[i].seq, i);                                      \
+                                                                               \
+    q->cap = cap;                                                              \
+    atomic_init(&q->enq_pos, 0);                                               \
+    atomic_init(&q->deq_pos, 0);                                               \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popb(struct NAME * l)                                                   \
+NAME##_deinit(struct NAME * q)                                                 \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
-    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
-                                                                               \
-    if(l->size == 1)                                                           \
-    {                                                                          \
-        free(l->head);                                                         \
-        l->head = NULL;                                                        \
-        l->tail = NULL;                                                        \
-    }                                                                          \
-    else                                                                       \
-    {                                                                          \
-        struct NAME##_node* old_tail = l->tail;                                \
-        l->tail = l->tail->prev;                                               \
-        l->tail->next = NULL;                                                  \
-        free(old_tail);                                                        \
-    }                                                                          \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    --(l->size);                                                               \
+    free(q->cells);                                                            \
+    q->cells = NULL;                                                           \
+    q->cap = 0;                                                                \
+    atomic_store_explicit(&q->enq_pos, 0, memory_order_relaxed);               \
+    atomic_store_explicit(&q->deq_pos, 0, memory_order_relaxed);               \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty(struct NAME * l)                                                  \
+NAME##_try_push(struct NAME * q, TYPE data)                                    \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    while(l->size > 0)                                                         \
-        NAME##_popf(l);                                                        \
+    struct NAME##_cell * cell;                                                 \
+    size_t pos = atomic_load_explicit(&q->enq_pos, memory_order_relaxed);      \
+                                                                               \
+    for(;;)                                                                    \
+    {                                                                          \
+        cell = &q->cells[pos & (q->cap - 1)];                                  \
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);   \
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;                         \
+                                                                               \
+        if(diff == 0)                                                          \
+        {                                                                      \
+            if(atomic_compare_exchange_weak_explicit(&q->enq_pos, &pos,        \
+                    pos + 1, memory_order_relaxed, memory_order_relaxed))      \
+                break;                                                         \
+        }                                                                      \
+        else if(diff < 0)                                                      \
+        {                                                                      \
+            return GENC_ERR_FULL;                                              \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            pos = atomic_load_explicit(&q->enq_pos, memory_order_relaxed);     \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    cell->data = data;                                                         \
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);          \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_ins_after(struct NAME * l, TYPE data, struct NAME##_node* n)            \
+NAME##_try_pop(struct NAME * q, TYPE * out)                                    \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    if((n == NULL) || (n == l->tail))                                          \
+    struct NAME##_cell * cell;                                                 \
+    size_t pos = atomic_load_explicit(&q->deq_pos, memory_order_relaxed);      \
+                                                                               \
+    for(;;)                                                                    \
     {                                                                          \
-        int err;                                                               \
+        cell = &q->cells[pos & (q->cap - 1)];                                  \
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);   \
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);                   \
                                                                                \
-        if(n == NULL)                                                          \
-            err = NAME##_pushf(l, data);                                       \
+        if(diff == 0)                                                          \
+        {                                                                      \
+            if(atomic_compare_exchange_weak_explicit(&q->deq_pos, &pos,        \
+                    pos + 1, memory_order_relaxed, memory_order_relaxed))      \
+                break;                                                         \
+        }                                                                      \
+        else if(diff < 0)                                                      \
+        {                                                                      \
+            return GENC_ERR_NO_DATA;                                           \
+        }                                                                      \
         else                                                                   \
-            err = NAME##_pushb(l, data);                                       \
-                                                                               \
-        switch(err)                                                            \
         {                                                                      \
-            case 0:                                                            \
-                return 0;                                                      \
-            case GENC_ERR_ALLOC_FAIL:                                          \
-                return GENC_ERR_ALLOC_FAIL;                                    \
-            default:                                                           \
-                return GENC_ERR_UNEXPECTED;                                    \
+            pos = atomic_load_explicit(&q->deq_pos, memory_order_relaxed);     \
         }                                                                      \
     }                                                                          \
                                                                                \
-    struct NAME##_node* new_node = malloc(sizeof(struct NAME##_node));         \
-    if(new_node == NULL) return GENC_ERR_ALLOC_FAIL;                           \
-                                                                               \
-    new_node->data = data;                                                     \
+    if(out) *out = cell->data;                                                 \
+    atomic_store_explicit(&cell->seq, pos + q->cap, memory_order_release);     \
                                                                                \
-    struct NAME##_node* next = n->next;                                        \
+    return 0;                                                                  \
+}                                                                              \
                                                                                \
-    n->next = new_node;                                                        \
-    new_node->prev = n;                                                        \
-    new_node->next = next;                                                     \
-    next->prev = new_node;                                                     \
+FN_PREFIX int                                                                  \
+NAME##_push(struct NAME * q, TYPE data)                                        \
+{                                                                              \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    ++(l->size);                                                               \
+    while(NAME##_try_push(q, data) == GENC_ERR_FULL)                           \
+        GENC_SPIN_YIELD();                                                     \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_ins_before(struct NAME * l, TYPE data, struct NAME##_node* n)           \
+NAME##_pop(struct NAME * q, TYPE * out)                                        \
 {                                                                              \
-    if(!l || !n) return GENC_ERR_INV_ARG;                                      \
+    if(!q) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    int err = NAME##_ins_after(l, data, n->prev);                              \
+    while(NAME##_try_pop(q, out) == GENC_ERR_NO_DATA)                          \
+        GENC_SPIN_YIELD();                                                     \
                                                                                \
-    switch(err)                                                                \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_push_many(struct NAME * q, TYPE const * data, size_t count)             \
+{                                                                              \
+    if(!q || !data) return 0;                                                  \
+                                                                               \
+    if(count > q->cap) count = q->cap;                                         \
+                                                                               \
+    size_t pos = atomic_load_explicit(&q->enq_pos, memory_order_relaxed);      \
+    size_t n;                                                                  \
+                                                                               \
+    for(;;)                                                                    \
     {                                                                          \
-        case 0:                                                                \
-            return 0;                                                          \
-        case GENC_ERR_ALLOC_FAIL:                                              \
-            return GENC_ERR_ALLOC_FAIL;                                        \
-        default:                                                               \
-            return GENC_ERR_UNEXPECTED;                                        \
+        /* A free cell can only be filled by the producer that claims its      \
+         * position, so cells seen free stay free until the claim. */          \
+        for(n = 0; n < count; n++)                                             \
+        {                                                                      \
+            struct NAME##_cell * cell = &q->cells[(pos + n) & (q->cap - 1)];   \
+            size_t seq = atomic_load_explicit(&cell->seq,                      \
+                                              memory_order_acquire);           \
+            if(seq != pos + n) break;                                          \
+        }                                                                      \
+                                                                               \
+        if(n == 0)                                                             \
+        {                                                                      \
+            size_t cur = atomic_load_explicit(&q->enq_pos,                     \
+                                              memory_order_relaxed);           \
+            if(cur == pos) return 0;                                           \
+            pos = cur;                                                         \
+            continue;                                                          \
+        }                                                                      \
+                                                                               \
+        if(atomic_compare_exchange_weak_explicit(&q->enq_pos, &pos,            \
+                pos + n, memory_order_relaxed, memory_order_relaxed))          \
+            break;                                                             \
+    }                                                                          \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < n; i++)                                                     \
+    {                                                                          \
+        struct NAME##_cell * cell = &q->cells[(pos + i) & (q->cap - 1)];       \
+        cell->data = data[i];                                                  \
+        atomic_store_explicit(&cell->seq, pos + i + 1, memory_order_release);  \
     }                                                                          \
+                                                                               \
+    return n;                                                                  \
 }                                                                              \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_rm(struct NAME * l, struct NAME##_node* n)                              \
+FN_PREFIX size_t                                                               \
+NAME##_pop_many(struct NAME * q, TYPE * out, size_t count)                     \
 {                                                                              \
-    if(!l || !n) return GENC_ERR_INV_ARG;                                      \
+    if(!q) return 0;                                                           \
                                                                                \
-    if((n == l->head) || (n == l->tail))                                       \
-    {                                                                          \
-        int err;                                                               \
+    if(count > q->cap) count = q->cap;                                         \
                                                                                \
-        if(n == l->head)                                                       \
-            err = NAME##_popf(l);                                              \
-        else                                                                   \
-            err = NAME##_popb(l);                                              \
+    size_t pos = atomic_load_explicit(&q->deq_pos, memory_order_relaxed);      \
+    size_t n;                                                                  \
                                                                                \
-        switch(err)                                                            \
+    for(;;)                                                                    \
+    {                                                                          \
+        for(n = 0; n < count; n++)                                             \
         {                                                                      \
-            case 0:                                                            \
-                return 0;                                                      \
-            default:                                                           \
-                return GENC_ERR_UNEXPECTED;                                    \
+            struct NAME##_cell * cell = &q->cells[(pos + n) & (q->cap - 1)];   \
+            size_t seq = atomic_load_explicit(&cell->seq,                      \
+                                              memory_order_acquire);           \
+            if(seq != pos + n + 1) break;                                      \
+        }                                                                      \
+                                                                               \
+        if(n == 0)                                                             \
+        {                                                                      \
+            size_t cur = atomic_load_explicit(&q->deq_pos,                     \
+                                              memory_order_relaxed);           \
+            if(cur == pos) return 0;                                           \
+            pos = cur;                                                         \
+            continue;                                                          \
         }                                                                      \
+                                                                               \
+        if(atomic_compare_exchange_weak_explicit(&q->deq_pos, &pos,            \
+                pos + n, memory_order_relaxed, memory_order_relaxed))          \
+            break;                                                             \
     }                                                                          \
                                                                                \
-    struct NAME##_node* prev = n->prev;                                        \
-    struct NAME##_node* next = n->next;                                        \
+    size_t i;                                                                  \
+    for(i = 0; i < n; i++)                                                     \
+    {                                                                          \
+        struct NAME##_cell * cell = &q->cells[(pos + i) & (q->cap - 1)];       \
+        if(out) out[i] = cell->data;                                           \
+        atomic_store_explicit(&cell->seq, pos + i + q->cap,                    \
+                              memory_order_release);                           \
+    }                                                                          \
                                                                                \
-    prev->next = next;                                                         \
-    next->prev = prev;                                                         \
+    return n;                                                                  \
+}                                                                              \
                                                                                \
-    free(n);                                                                   \
-    --(l->size);                                                               \
+FN_PREFIX size_t                                                               \
+NAME##_size(struct NAME * q)                                                   \
+{                                                                              \
+    if(!q) return 0;                                                           \
                                                                                \
-    return 0;                                                                  \
+    size_t deq = atomic_load_explicit(&q->deq_pos, memory_order_acquire);      \
+    size_t enq = atomic_load_explicit(&q->enq_pos, memory_order_acquire);      \
+                                                                               \
+    return (enq > deq) ? (enq - deq) : 0;                                      \
 }                                                                              \
 
 /* -------------------------------------------------------------------------- */
-/* LIST - INLINE */
+/* MPMC QUEUE - INLINE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_LIST_INLINE(NAME, TYPE)                                           \
-    GENC_LIST_DECLARE(NAME, TYPE, static inline)                               \
-    GENC_LIST_DEFINE(NAME, TYPE, static inline)                                \
+#define GENC_MPMC_QUEUE_INLINE(NAME, TYPE)                                     \
+    GENC_MPMC_QUEUE_DECLARE(NAME, TYPE, static inline)                         \
+    GENC_MPMC_QUEUE_DEFINE(NAME, TYPE, static inline)                          \
+
+#endif // GENC_HAS_ATOMICS
 
 /* ========================================================================== */
 /* -------------------------------------------------------------------------- */
-/* FWD LIST */
+/* ATOMIC STACK */
 /* -------------------------------------------------------------------------- */
 /* ========================================================================== */
 
-/* GENC_FWD_LIST_DECLARE() and GENC_FWD_LIST_DEFINE() generate a type-safe
- * forward list API intended for stack or queue use. GENC_FWD_LIST_INLINE()
- * generates both with `static inline`.
+/* GENC_ATOMIC_STACK_DECLARE() and GENC_ATOMIC_STACK_DEFINE() generate a
+ * type-safe lock-free stack API (Treiber stack). GENC_ATOMIC_STACK_INLINE()
+ * generates both with `static inline`. Available only with C11 atomics
+ * (GENC_HAS_ATOMICS).
  *
- * The generated structure must be zero-initialized before its first use. */
+ * Nodes have the same layout as GENC_FWD_LIST nodes. Any number of threads
+ * may push concurrently, and any number of threads may detach the whole stack
+ * with <name>_pop_all(); both are immune to ABA. Popping single elements is
+ * not: <name>_pop() and <name>_pop_node() may run concurrently with pushes, but
+ * not with each other or with <name>_pop_all(). Multi-consumer users, such as
+ * shared free lists, should detach the stack with <name>_pop_all() and consume
+ * the returned chain privately.
+ *
+ * Nodes handed to the stack by the caller must be allocated with malloc() if
+ * they may later be released by <name>_pop() or <name>_deinit().
+ *
+ * The generated structure must be zero-initialized before its first use.
+ * Deinit must not run concurrently with any other operation. */
+
+#ifdef GENC_HAS_ATOMICS
 
 /* ========================================================================== */
-/* FWD LIST - PROTOTYPES */
+/* ATOMIC STACK - PROTOTYPES */
 /* ========================================================================== */
 
 /* --------------------------------------------------------|
@@ -1223,85 +11116,100 @@ struct <name>_node
 
 struct <name>
 {
-    struct <name>_node *head, *tail;
-    size_t size;
+    _Alignas(GENC_CACHE_LINE_SIZE) _Atomic(struct <name>_node*) head;
 };
 
 |----------------------------------------------------------|
 
-* Deinitializes the list and frees all nodes.
+* Frees all nodes.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_INV_ARG: `stack` is NULL.
 
-int <name>_deinit(struct <name>* list);
+int <name>_deinit(struct <name>* stack);
 
 |----------------------------------------------------------|
 
-* Appends an element to the list.
+* Allocates a node holding `data` and pushes it.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_INV_ARG: `stack` is NULL.
 * GENC_ERR_ALLOC_FAIL: Memory allocation failed.
 
-int <name>_pushb(struct <name>* list, <type> data);
+int <name>_push(struct <name>* stack, <type> data);
 
 |----------------------------------------------------------|
 
-* Prepends an element to the list.
+* Pushes the caller-owned `node`. Ownership passes to the stack.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
-* GENC_ERR_ALLOC_FAIL: Memory allocation failed.
+* GENC_ERR_INV_ARG: `stack` or `node` is NULL.
 
-int <name>_pushf(struct <name>* list, <type> data);
+int <name>_push_node(struct <name>* stack, struct <name>_node* node);
 
 |----------------------------------------------------------|
 
-* Removes the first element from the list.
+* Pushes the chain `first` ... `last`, linked through `next`, with a single
+* atomic update. `first` ends up on top. Ownership passes to the stack.
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
-* GENC_ERR_NO_DATA: The list is empty.
+* GENC_ERR_INV_ARG: `stack`, `first` or `last` is NULL.
 
-int <name>_popf(struct <name>* list);
+int <name>_push_chain(struct <name>* stack, struct <name>_node* first,
+                      struct <name>_node* last);
 
 |----------------------------------------------------------|
 
-* Removes all elements and frees all nodes.
+* Detaches and returns the whole stack as a NULL-terminated chain, top
+* first. Ownership of the nodes passes to the caller.
+
+* RETURN VALUE: The first node of the chain, NULL if the stack is empty or
+* `stack` is NULL.
+
+struct <name>_node* <name>_pop_all(struct <name>* stack);
+
+|----------------------------------------------------------|
+
+* Detaches and returns the top node. Ownership passes to the caller.
+* Single consumer only (see above).
+
+* RETURN VALUE: The detached node, NULL if the stack is empty or `stack` is
+* NULL.
+
+struct <name>_node* <name>_pop_node(struct <name>* stack);
+
+|----------------------------------------------------------|
+
+* Removes the top element and frees its node. If `out` is non-NULL, the
+* element is copied to it. Single consumer only (see above).
 
 * RETURN VALUE: 0 on success, error code on failure.
 
 * ERROR CODES:
-* GENC_ERR_INV_ARG: `list` is NULL.
+* GENC_ERR_INV_ARG: `stack` is NULL.
+* GENC_ERR_NO_DATA: The stack is empty.
 
-int <name>_empty(struct <name>* list);
+int <name>_pop(struct <name>* stack, <type>* out);
 
 |-------------------------------------------------------- */
 
 /* ========================================================================== */
-/* FWD LIST - GENERATOR MACROS */
+/* ATOMIC STACK - GENERATOR MACROS */
 /* ========================================================================== */
 
 /* -------------------------------------------------------------------------- */
-/* FWD LIST - DECLARE */
+/* ATOMIC STACK - DECLARE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_FWD_LIST_DECLARE(NAME, TYPE, FN_PREFIX)                           \
-                                                                               \
-struct NAME                                                                    \
-{                                                                              \
-    struct NAME##_node *head, *tail;                                           \
-    size_t size;                                                               \
-};                                                                             \
+#define GENC_ATOMIC_STACK_DECLARE(NAME, TYPE, FN_PREFIX)                       \
                                                                                \
 struct NAME##_node                                                             \
 {                                                                              \
@@ -1309,33 +11217,45 @@ struct NAME##_node                                                             \
     struct NAME##_node* next;                                                  \
 };                                                                             \
                                                                                \
+struct NAME                                                                    \
+{                                                                              \
+    _Alignas(GENC_CACHE_LINE_SIZE) _Atomic(struct NAME##_node*) head;          \
+};                                                                             \
+                                                                               \
 FN_PREFIX int                                                                  \
-NAME##_deinit(struct NAME * l);                                                \
+NAME##_deinit(struct NAME * s);                                                \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushb(struct NAME * l, TYPE data);                                      \
+NAME##_push(struct NAME * s, TYPE data);                                       \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushf(struct NAME * l, TYPE data);                                      \
+NAME##_push_node(struct NAME * s, struct NAME##_node* node);                   \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_popf(struct NAME * l);                                                  \
+NAME##_push_chain(struct NAME * s, struct NAME##_node* first,                  \
+                  struct NAME##_node* last);                                   \
+                                                                               \
+FN_PREFIX struct NAME##_node*                                                  \
+NAME##_pop_all(struct NAME * s);                                               \
+                                                                               \
+FN_PREFIX struct NAME##_node*                                                  \
+NAME##_pop_node(struct NAME * s);                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty(struct NAME * l);                                                 \
+NAME##_pop(struct NAME * s, TYPE * out);                                       \
 
 /* -------------------------------------------------------------------------- */
-/* FWD LIST - DEFINE */
+/* ATOMIC STACK - DEFINE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_FWD_LIST_DEFINE(NAME, TYPE, FN_PREFIX)                            \
+#define GENC_ATOMIC_STACK_DEFINE(NAME, TYPE, FN_PREFIX)                        \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_deinit(struct NAME * l)                                                 \
+NAME##_deinit(struct NAME * s)                                                 \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(!s) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    struct NAME##_node* it = l->head;                                          \
+    struct NAME##_node* it = NAME##_pop_all(s);                                \
     struct NAME##_node* next;                                                  \
     while(it)                                                                  \
     {                                                                          \
@@ -1344,96 +11264,97 @@ NAME##_deinit(struct NAME * l)                                                 \
         it = next;                                                             \
     }                                                                          \
                                                                                \
-    l->size = 0;                                                               \
-    l->head = NULL;                                                            \
-    l->tail = NULL;                                                            \
-                                                                               \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushb(struct NAME * l, TYPE data)                                       \
+NAME##_push(struct NAME * s, TYPE data)                                        \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(!s) return GENC_ERR_INV_ARG;                                            \
                                                                                \
     struct NAME##_node* node = malloc(sizeof(struct NAME##_node));             \
     if(node == NULL) return GENC_ERR_ALLOC_FAIL;                               \
                                                                                \
     node->data = data;                                                         \
-    node->next = NULL;                                                         \
-                                                                               \
-    if(l->size == 0)                                                           \
-    {                                                                          \
-        l->head = node;                                                        \
-        l->tail = node;                                                        \
-    }                                                                          \
-    else                                                                       \
-    {                                                                          \
-        l->tail->next = node;                                                  \
-        l->tail = node;                                                        \
-    }                                                                          \
                                                                                \
-    ++(l->size);                                                               \
-                                                                               \
-    return 0;                                                                  \
+    return NAME##_push_chain(s, node, node);                                   \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_pushf(struct NAME * l, TYPE data)                                       \
+NAME##_push_node(struct NAME * s, struct NAME##_node* node)                    \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
-                                                                               \
-    struct NAME##_node* node = malloc(sizeof(struct NAME##_node));             \
-    if(node == NULL) return GENC_ERR_ALLOC_FAIL;                               \
+    return NAME##_push_chain(s, node, node);                                   \
+}                                                                              \
                                                                                \
-    node->data = data;                                                         \
-    node->next = l->head;                                                      \
+FN_PREFIX int                                                                  \
+NAME##_push_chain(struct NAME * s, struct NAME##_node* first,                  \
+                  struct NAME##_node* last)                                    \
+{                                                                              \
+    if(!s || !first || !last) return GENC_ERR_INV_ARG;                         \
                                                                                \
-    if(l->size == 0)                                                           \
-        l->tail = node;                                                        \
+    struct NAME##_node* head =                                                 \
+        atomic_load_explicit(&s->head, memory_order_relaxed);                  \
                                                                                \
-    l->head = node;                                                            \
-    ++(l->size);                                                               \
+    do                                                                         \
+    {                                                                          \
+        last->next = head;                                                     \
+    } while(!atomic_compare_exchange_weak_explicit(&s->head, &head, first,     \
+                memory_order_release, memory_order_relaxed));                  \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
                                                                                \
-FN_PREFIX int                                                                  \
-NAME##_popf(struct NAME * l)                                                   \
+FN_PREFIX struct NAME##_node*                                                  \
+NAME##_pop_all(struct NAME * s)                                                \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
-    if(l->size == 0) return GENC_ERR_NO_DATA;                                  \
+    if(!s) return NULL;                                                        \
                                                                                \
-    struct NAME##_node* old_head = l->head;                                    \
+    return atomic_exchange_explicit(&s->head, NULL, memory_order_acquire);     \
+}                                                                              \
                                                                                \
-    l->head = l->head->next;                                                   \
-    free(old_head);                                                            \
+FN_PREFIX struct NAME##_node*                                                  \
+NAME##_pop_node(struct NAME * s)                                               \
+{                                                                              \
+    if(!s) return NULL;                                                        \
                                                                                \
-    --(l->size);                                                               \
+    struct NAME##_node* head =                                                 \
+        atomic_load_explicit(&s->head, memory_order_acquire);                  \
                                                                                \
-    if(l->size == 0)                                                           \
-        l->tail = NULL;                                                        \
+    while(head)                                                                \
+    {                                                                          \
+        if(atomic_compare_exchange_weak_explicit(&s->head, &head,              \
+                head->next, memory_order_acquire, memory_order_acquire))       \
+        {                                                                      \
+            head->next = NULL;                                                 \
+            break;                                                             \
+        }                                                                      \
+    }                                                                          \
                                                                                \
-    return 0;                                                                  \
+    return head;                                                               \
 }                                                                              \
                                                                                \
 FN_PREFIX int                                                                  \
-NAME##_empty(struct NAME * l)                                                  \
+NAME##_pop(struct NAME * s, TYPE * out)                                        \
 {                                                                              \
-    if(!l) return GENC_ERR_INV_ARG;                                            \
+    if(!s) return GENC_ERR_INV_ARG;                                            \
                                                                                \
-    while(l->size > 0)                                                         \
-        NAME##_popf(l);                                                        \
+    struct NAME##_node* node = NAME##_pop_node(s);                             \
+    if(!node) return GENC_ERR_NO_DATA;                                         \
+                                                                               \
+    if(out) *out = node->data;                                                 \
+    free(node);                                                                \
                                                                                \
     return 0;                                                                  \
 }                                                                              \
 
 /* -------------------------------------------------------------------------- */
-/* FWD LIST - INLINE */
+/* ATOMIC STACK - INLINE */
 /* -------------------------------------------------------------------------- */
 
-#define GENC_FWD_LIST_INLINE(NAME, TYPE)                                       \
-    GENC_FWD_LIST_DECLARE(NAME, TYPE, static inline)                           \
-    GENC_FWD_LIST_DEFINE(NAME, TYPE, static inline)                            \
+#define GENC_ATOMIC_STACK_INLINE(NAME, TYPE)                                   \
+    GENC_ATOMIC_STACK_DECLARE(NAME, TYPE, static inline)                       \
+    GENC_ATOMIC_STACK_DEFINE(NAME, TYPE, static inline)                        \
+
+#endif // GENC_HAS_ATOMICS
 
 #endif // GENC_H
@@ -0,0 +1,212 @@
+#include "genc.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+GENC_DEQUE_INLINE(int_deque, int, 2.0)
+
+#define REF_CAP 8192
+
+/* Reference deque: a plain array with room on both sides. */
+static int ref[2 * REF_CAP];
+static size_t ref_head = REF_CAP;
+static size_t ref_size = 0;
+
+static uint64_t rng_state = 88172645463325252u;
+
+static uint64_t
+rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+
+    return rng_state;
+}
+
+static void
+check(struct int_deque* d)
+{
+    assert(d->size == ref_size);
+    assert(d->size <= d->cap);
+    assert((d->cap & (d->cap - 1)) == 0);
+    assert((d->cap == 0) || (d->head < d->cap));
+
+    size_t i;
+    for(i = 0; i < ref_size; i++)
+        assert(*int_deque_at(d, i) == ref[ref_head + i]);
+    assert(int_deque_at(d, ref_size) == NULL);
+}
+
+static void
+test_wrap_grow(void)
+{
+    struct int_deque d = {0};
+
+    /* Both ways of unwrapping on growth: the wrapped part is the shorter one
+     * (moved past the old end), or the longer one (the front part is moved
+     * to the new end). */
+    size_t pops;
+    for(pops = 1; pops < 8; pops++)
+    {
+        assert(!int_deque_prealloc(&d, 8));
+        assert(d.cap == 8);
+
+        int next = 0;
+        int front = 0;
+
+        size_t i;
+        for(i = 0; i < 8; i++)
+            assert(!int_deque_pushb(&d, next++));
+        for(i = 0; i < pops; i++)
+        {
+            assert(!int_deque_popf(&d));
+            front++;
+        }
+        for(i = 0; i < pops; i++)
+            assert(!int_deque_pushb(&d, next++));
+        assert(d.cap == 8);
+        assert(d.head + d.size > d.cap);
+
+        assert(!int_deque_pushb(&d, next++));
+        assert(d.cap == 16);
+
+        for(i = 0; i < d.size; i++)
+            assert(*int_deque_at(&d, i) == front + (int)i);
+
+        assert(!int_deque_deinit(&d));
+    }
+}
+
+static void
+test_churn(void)
+{
+    struct int_deque d = {0};
+    int buf[64];
+    int out[64];
+    int next = 0;
+
+    int op;
+    for(op = 0; op < 200000; op++)
+    {
+        /* Drift between growing and draining phases so that the deque both
+         * grows and shrinks while wrapped. */
+        bool grow = (op / 5000) % 2 == 0;
+        int kind = (int)(rng() % 10);
+        size_t count = (size_t)(rng() % 64);
+
+        if(ref_size + count >= REF_CAP - 64) grow = false;
+
+        /* While draining, most pushes become pops. */
+        if(!grow && (kind >= 2) && (kind < 6)) kind += 4;
+
+        if(kind < 4)
+        {
+            int val = next++;
+            if(kind % 2 == 0)
+            {
+                assert(!int_deque_pushb(&d, val));
+                ref[ref_head + ref_size++] = val;
+            }
+            else
+            {
+                assert(!int_deque_pushf(&d, val));
+                ref[--ref_head] = val;
+                ref_size++;
+            }
+        }
+        else if(kind < 6)
+        {
+            size_t i;
+            for(i = 0; i < count; i++)
+                buf[i] = next++;
+
+            if(kind == 4)
+            {
+                assert(!int_deque_pushb_many(&d, buf, count));
+                memcpy(ref + ref_head + ref_size, buf, count * sizeof(int));
+            }
+            else
+            {
+                assert(!int_deque_pushf_many(&d, buf, count));
+                ref_head -= count;
+                memcpy(ref + ref_head, buf, count * sizeof(int));
+            }
+            ref_size += count;
+        }
+        else if(kind < 8)
+        {
+            int status = (kind == 6) ? int_deque_popb(&d) : int_deque_popf(&d);
+            if(ref_size == 0)
+            {
+                assert(status == GENC_ERR_NO_DATA);
+                continue;
+            }
+            assert(!status);
+            if(kind == 7) ref_head++;
+            ref_size--;
+        }
+        else
+        {
+            if(count > ref_size)
+            {
+                assert(int_deque_popb_many(&d, out, count) ==
+                       GENC_ERR_OUT_OF_BOUNDS);
+                count = ref_size;
+            }
+
+            if(kind == 8)
+            {
+                assert(!int_deque_popb_many(&d, out, count));
+                assert(!memcmp(out, ref + ref_head + ref_size - count,
+                               count * sizeof(int)));
+            }
+            else
+            {
+                assert(!int_deque_popf_many(&d, out, count));
+                assert(!memcmp(out, ref + ref_head, count * sizeof(int)));
+                ref_head += count;
+            }
+            ref_size -= count;
+        }
+
+        if(op % 97 == 0) assert(!int_deque_shrink(&d));
+        if(op % 101 == 0) check(&d);
+
+        /* Recenter the reference so that it never runs off either side. */
+        if((ref_head < 2 * 64) || (ref_head + ref_size > 2 * REF_CAP - 2 * 64))
+        {
+            memmove(ref + REF_CAP / 2, ref + ref_head, ref_size * sizeof(int));
+            ref_head = REF_CAP / 2;
+        }
+    }
+    check(&d);
+
+    /* Draining and shrinking releases the buffer. */
+    size_t cap = d.cap;
+    while(ref_size > 0)
+    {
+        assert(!int_deque_popf(&d));
+        ref_head++;
+        ref_size--;
+        assert(!int_deque_shrink(&d));
+        assert(d.cap <= cap);
+        cap = d.cap;
+        check(&d);
+    }
+    assert(!int_deque_shrink(&d));
+    assert(d.cap == 0);
+
+    assert(!int_deque_empty(&d));
+    assert(!int_deque_deinit(&d));
+}
+
+int main()
+{
+    test_wrap_grow();
+    test_churn();
+
+    printf("test_deque: ok\n");
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "genc.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#define KEY_RANGE 4096
+
+#define INT_HASH(key) ((uint64_t)(key))
+#define INT_EQ(a, b) ((a) == (b))
+
+/* Only four distinct hashes: every probe run is long, crosses the 16-slot
+ * group boundary and wraps around the end of the table. */
+#define BAD_HASH(key) ((uint64_t)(key) & 3)
+
+GENC_HMAP_INLINE(int_map, int, int, INT_HASH, INT_EQ)
+GENC_HMAP_INLINE(bad_map, int, int, BAD_HASH, INT_EQ)
+GENC_HSET_INLINE(int_set, int, INT_HASH, INT_EQ)
+
+static uint64_t rng_state = 88172645463325252u;
+
+static uint64_t
+rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+
+    return rng_state;
+}
+
+/* Checks that the map holds exactly the keys with `present[key]` set, each
+ * with the value `vals[key]`. */
+#define CHECK_MAP(NAME, MAP, PRESENT, VALS)                                    \
+do                                                                             \
+{                                                                              \
+    size_t count = 0;                                                          \
+    int key;                                                                   \
+    for(key = 0; key < KEY_RANGE; key++)                                       \
+    {                                                                          \
+        int* val = NAME##_get((MAP), key);                                     \
+        assert(NAME##_has((MAP), key) == (PRESENT)[key]);                      \
+        assert((val != NULL) == (PRESENT)[key]);                               \
+        if(val) assert(*val == (VALS)[key]);                                   \
+        count += (PRESENT)[key];                                               \
+    }                                                                          \
+    assert((MAP)->size == count);                                              \
+                                                                               \
+    size_t it = 0;                                                             \
+    size_t seen = 0;                                                           \
+    struct NAME##_slot* slot;                                                  \
+    while((slot = NAME##_next((MAP), &it)))                                    \
+    {                                                                          \
+        assert((PRESENT)[slot->key]);                                          \
+        seen++;                                                                \
+    }                                                                          \
+    assert(seen == count);                                                     \
+} while(0)
+
+#define CHURN(NAME, KEYS, ROUNDS)                                              \
+do                                                                             \
+{                                                                              \
+    struct NAME map = {0};                                                     \
+    static bool present[KEY_RANGE];                                            \
+    static int vals[KEY_RANGE];                                                \
+    memset(present, 0, sizeof(present));                                       \
+                                                                               \
+    int round;                                                                 \
+    for(round = 0; round < (ROUNDS); round++)                                  \
+    {                                                                          \
+        int op;                                                                \
+        for(op = 0; op < 2000; op++)                                           \
+        {                                                                      \
+            int key = (int)(rng() % (KEYS));                                   \
+            if(rng() % 3 != 0)                                                 \
+            {                                                                  \
+                vals[key] = (int)(rng() & 0xffff);                             \
+                assert(!NAME##_put(&map, key, vals[key]));                     \
+                present[key] = true;                                           \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                int status = NAME##_rm(&map, key);                             \
+                assert(status == (present[key] ? 0 : GENC_ERR_NO_DATA));       \
+                present[key] = false;                                          \
+            }                                                                  \
+        }                                                                      \
+        CHECK_MAP(NAME, &map, present, vals);                                  \
+                                                                               \
+        /* Shrink and regrow so that the runs are rebuilt at other sizes. */   \
+        assert(!NAME##_rehash(&map, 0));                                       \
+        CHECK_MAP(NAME, &map, present, vals);                                  \
+        assert(!NAME##_reserve(&map, map.size * 2 + 1));                       \
+        CHECK_MAP(NAME, &map, present, vals);                                  \
+    }                                                                          \
+                                                                               \
+    /* Drain: every removal shifts the rest of its run back. */                \
+    int key;                                                                   \
+    for(key = 0; key < KEY_RANGE; key++)                                       \
+    {                                                                          \
+        if(!present[key]) continue;                                            \
+        assert(!NAME##_rm(&map, key));                                         \
+        present[key] = false;                                                  \
+    }                                                                          \
+    CHECK_MAP(NAME, &map, present, vals);                                      \
+    assert(map.size == 0);                                                     \
+                                                                               \
+    assert(!NAME##_deinit(&map));                                              \
+} while(0)
+
+static void
+test_map_churn(void)
+{
+    CHURN(int_map, KEY_RANGE, 20);
+    CHURN(int_map, 40, 20);
+}
+
+static void
+test_map_collisions(void)
+{
+    /* Few keys, so the table stays small and the runs wrap often. */
+    CHURN(bad_map, 24, 20);
+    CHURN(bad_map, 200, 10);
+}
+
+static void
+test_map_group_boundary(void)
+{
+    struct bad_map map = {0};
+
+    /* 20 keys with one hash fill one run past the first 16-slot group. */
+    int key;
+    for(key = 0; key < 80; key += 4)
+        assert(!bad_map_put(&map, key, key + 1));
+    assert(map.size == 20);
+
+    /* Removing from the front shifts every later key back over the group
+     * boundary. */
+    for(key = 0; key < 80; key += 8)
+    {
+        assert(!bad_map_rm(&map, key));
+        assert(bad_map_rm(&map, key) == GENC_ERR_NO_DATA);
+
+        int other;
+        for(other = 0; other < 80; other += 4)
+        {
+            int* val = bad_map_get(&map, other);
+            bool removed = (other % 8 == 0) && (other <= key);
+            assert((val == NULL) == removed);
+            if(val) assert(*val == other + 1);
+        }
+    }
+    assert(map.size == 10);
+
+    assert(!bad_map_empty(&map));
+    assert(map.size == 0);
+    assert(!bad_map_has(&map, 4));
+
+    assert(!bad_map_deinit(&map));
+}
+
+static void
+test_set(void)
+{
+    struct int_set a = {0};
+    struct int_set b = {0};
+    struct int_set out = {0};
+
+    int keys[100];
+    bool added[100];
+
+    size_t i;
+    for(i = 0; i < 100; i++)
+        keys[i] = (int)(i % 60) * 2;
+
+    assert(!int_set_ins_many(&a, keys, 100, added));
+    assert(a.size == 60);
+    for(i = 0; i < 100; i++)
+        assert(added[i] == (i < 60));
+
+    for(i = 0; i < 100; i++)
+        keys[i] = (int)i * 3;
+    assert(!int_set_ins_many(&b, keys, 100, NULL));
+
+    bool found[100];
+    assert(!int_set_has_many(&a, keys, 100, found));
+    for(i = 0; i < 100; i++)
+        assert(found[i] == ((keys[i] % 2 == 0) && (keys[i] < 120)));
+
+    assert(!int_set_union(&out, &a, &b));
+    int key;
+    for(key = 0; key < 300; key++)
+    {
+        bool in_a = (key % 2 == 0) && (key < 120);
+        bool in_b = key % 3 == 0;
+        assert(int_set_has(&out, key) == (in_a || in_b));
+    }
+
+    assert(!int_set_intersect(&out, &a, &b));
+    assert(out.size == 20);
+    for(key = 0; key < 300; key++)
+        assert(int_set_has(&out, key) == ((key % 6 == 0) && (key < 120)));
+
+    assert(int_set_union(&a, &a, &b) == GENC_ERR_INV_ARG);
+
+    assert(!int_set_deinit(&a));
+    assert(!int_set_deinit(&b));
+    assert(!int_set_deinit(&out));
+}
+
+int main()
+{
+    test_map_churn();
+    test_map_collisions();
+    test_map_group_boundary();
+    test_set();
+
+    printf("test_hmap: ok\n");
+
+    return 0;
+}
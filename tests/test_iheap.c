@@ -0,0 +1,191 @@
+#include "genc.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+GENC_IHEAP_INLINE(int_iheap2, int, *a < *b, 2)
+GENC_IHEAP_INLINE(int_iheap4, int, *a < *b, 4)
+
+#define MAX_HANDLES 4096
+
+static uint64_t rng_state = 88172645463325252u;
+
+static uint64_t
+rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+
+    return rng_state;
+}
+
+/* Runs random operations against a reference table of handles. Handles
+ * freed by pop or erase must be reissued, so no more handles than the peak
+ * size are ever used. */
+#define CHURN(NAME)                                                            \
+do                                                                             \
+{                                                                              \
+    struct NAME heap = {0};                                                    \
+    static bool live[MAX_HANDLES];                                             \
+    static int vals[MAX_HANDLES];                                              \
+    memset(live, 0, sizeof(live));                                             \
+    size_t size = 0;                                                           \
+    size_t peak = 0;                                                           \
+    size_t max_handle = 0;                                                     \
+                                                                               \
+    int op;                                                                    \
+    for(op = 0; op < 200000; op++)                                             \
+    {                                                                          \
+        bool grow = (op / 3000) % 2 == 0;                                      \
+        int kind = (int)(rng() % 8);                                           \
+        int val = (int)(rng() % 1000);                                         \
+        size_t handle = (size_t)(rng() % (max_handle + 1));                    \
+                                                                               \
+        if((kind < 3 && grow) || (size == 0))                                  \
+        {                                                                      \
+            if(size + 1 >= MAX_HANDLES) continue;                              \
+            assert(!NAME##_push(&heap, val, &handle));                         \
+            assert(handle < MAX_HANDLES);                                      \
+            assert(!live[handle]);                                             \
+            live[handle] = true;                                               \
+            vals[handle] = val;                                                \
+            if(++size > peak) peak = size;                                     \
+            if(handle > max_handle) max_handle = handle;                       \
+        }                                                                      \
+        else if(kind < 5)                                                      \
+        {                                                                      \
+            struct NAME##_node* top = NAME##_peek(&heap);                      \
+            assert(top && live[top->handle]);                                  \
+            assert(top->data == vals[top->handle]);                            \
+            size_t top_handle = top->handle;                                   \
+                                                                               \
+            size_t i;                                                          \
+            for(i = 0; i <= max_handle; i++)                                   \
+                assert(!live[i] || (vals[i] >= top->data));                    \
+                                                                               \
+            int out;                                                           \
+            assert(!NAME##_pop(&heap, &out));                                  \
+            assert(out == vals[top_handle]);                                   \
+            live[top_handle] = false;                                          \
+            size--;                                                            \
+            assert(NAME##_get(&heap, top_handle) == NULL);                     \
+        }                                                                      \
+        else if(!live[handle])                                                 \
+        {                                                                      \
+            assert(NAME##_get(&heap, handle) == NULL);                         \
+            assert(NAME##_erase(&heap, handle, NULL) == GENC_ERR_NO_DATA);     \
+            assert(NAME##_update(&heap, handle, val) == GENC_ERR_NO_DATA);     \
+        }                                                                      \
+        else if(kind == 5)                                                     \
+        {                                                                      \
+            int out;                                                           \
+            assert(!NAME##_erase(&heap, handle, &out));                        \
+            assert(out == vals[handle]);                                       \
+            live[handle] = false;                                              \
+            size--;                                                            \
+        }                                                                      \
+        else if(kind == 6)                                                     \
+        {                                                                      \
+            assert(!NAME##_update(&heap, handle, val));                        \
+            vals[handle] = val;                                                \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            int status = NAME##_decrease_key(&heap, handle, val);              \
+            if(val > vals[handle])                                             \
+            {                                                                  \
+                assert(status == GENC_ERR_INV_ARG);                            \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                assert(!status);                                               \
+                vals[handle] = val;                                            \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        assert(heap.size == size);                                             \
+        if(live[handle]) assert(*NAME##_get(&heap, handle) == vals[handle]);   \
+    }                                                                          \
+    assert(max_handle < peak);                                                 \
+                                                                               \
+    /* Draining yields the elements in order. */                               \
+    int prev = -1;                                                             \
+    while(heap.size > 0)                                                       \
+    {                                                                          \
+        int out;                                                               \
+        assert(!NAME##_pop(&heap, &out));                                      \
+        assert(out >= prev);                                                   \
+        prev = out;                                                            \
+    }                                                                          \
+    assert(NAME##_pop(&heap, NULL) == GENC_ERR_NO_DATA);                       \
+                                                                               \
+    assert(!NAME##_deinit(&heap));                                             \
+} while(0)
+
+static void
+test_handle_reuse(void)
+{
+    struct int_iheap4 heap = {0};
+
+    size_t a, b, c;
+    assert(!int_iheap4_push(&heap, 30, &a));
+    assert(!int_iheap4_push(&heap, 10, &b));
+    assert(!int_iheap4_push(&heap, 20, &c));
+    assert((a != b) && (b != c) && (a != c));
+
+    /* The popped element's handle goes out of use... */
+    int out;
+    assert(!int_iheap4_pop(&heap, &out));
+    assert(out == 10);
+    assert(int_iheap4_get(&heap, b) == NULL);
+    assert(int_iheap4_update(&heap, b, 5) == GENC_ERR_NO_DATA);
+
+    /* ...and is handed out again by the next push, now naming the new
+     * element. */
+    size_t d;
+    assert(!int_iheap4_push(&heap, 40, &d));
+    assert(d == b);
+    assert(*int_iheap4_get(&heap, d) == 40);
+
+    assert(!int_iheap4_decrease_key(&heap, d, 1));
+    assert(int_iheap4_peek(&heap)->handle == d);
+    assert(int_iheap4_decrease_key(&heap, d, 2) == GENC_ERR_INV_ARG);
+
+    assert(!int_iheap4_erase(&heap, a, &out));
+    assert(out == 30);
+    assert(!int_iheap4_push(&heap, 25, &d));
+    assert(d == a);
+
+    /* Handles from heapify are usable right away. */
+    int data[5] = { 9, 3, 7, 1, 5 };
+    size_t handles[5];
+    assert(!int_iheap4_heapify(&heap, data, 5, handles));
+    size_t i;
+    for(i = 0; i < 5; i++)
+        assert(*int_iheap4_get(&heap, handles[i]) == data[i]);
+    assert(!int_iheap4_update(&heap, handles[0], 0));
+    assert(int_iheap4_peek(&heap)->handle == handles[0]);
+
+    assert(!int_iheap4_empty(&heap));
+    assert(int_iheap4_get(&heap, handles[0]) == NULL);
+
+    assert(!int_iheap4_deinit(&heap));
+}
+
+static void
+test_churn(void)
+{
+    CHURN(int_iheap2);
+    CHURN(int_iheap4);
+}
+
+int main()
+{
+    test_handle_reuse();
+    test_churn();
+
+    printf("test_iheap: ok\n");
+
+    return 0;
+}
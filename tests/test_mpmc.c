@@ -0,0 +1,237 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <sched.h>
+
+/* Yield instead of spinning so that the blocking operations make progress
+ * when there are more threads than cores. */
+#define GENC_SPIN_YIELD() sched_yield()
+
+#include "genc.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+
+#ifndef GENC_HAS_ATOMICS
+#error "test_mpmc requires C11 atomics"
+#endif
+
+GENC_MPMC_QUEUE_INLINE(long_mpmc, long)
+
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define PER_PRODUCER 200000L
+#define TOTAL (PRODUCERS * PER_PRODUCER)
+
+/* Element values encode the producer and a per-producer sequence number. */
+#define ENCODE(producer, seq) ((long)(producer) * PER_PRODUCER + (seq))
+
+static struct long_mpmc queue;
+static atomic_long consumed;
+static atomic_uchar seen[TOTAL];
+
+static void
+test_single_thread(void)
+{
+    struct long_mpmc q;
+    assert(long_mpmc_init(&q, 0) == GENC_ERR_INV_ARG);
+    assert(!long_mpmc_init(&q, 1));
+    assert(q.cap == 2);
+    assert(!long_mpmc_deinit(&q));
+
+    assert(!long_mpmc_init(&q, 8));
+
+    long out;
+    assert(long_mpmc_try_pop(&q, &out) == GENC_ERR_NO_DATA);
+
+    long next_in = 0;
+    long next_out = 0;
+    int lap;
+    for(lap = 0; lap < 20; lap++)
+    {
+        while(long_mpmc_try_push(&q, next_in) == 0)
+            next_in++;
+        assert(long_mpmc_size(&q) == 8);
+        assert(long_mpmc_try_push(&q, -1) == GENC_ERR_FULL);
+
+        long buf[8];
+        size_t count = (size_t)(lap % 8) + 1;
+        assert(long_mpmc_pop_many(&q, buf, count) == count);
+
+        size_t i;
+        for(i = 0; i < count; i++)
+            assert(buf[i] == next_out++);
+
+        for(i = 0; i < 8; i++)
+            buf[i] = next_in + (long)i;
+        assert(long_mpmc_push_many(&q, buf, 8) == count);
+        next_in += (long)count;
+
+        while(long_mpmc_try_pop(&q, &out) == 0)
+            assert(out == next_out++);
+        assert(next_out == next_in);
+        assert(long_mpmc_size(&q) == 0);
+    }
+
+    assert(!long_mpmc_deinit(&q));
+}
+
+static void*
+producer(void* arg)
+{
+    long id = (long)(intptr_t)arg;
+    long buf[8];
+
+    long seq = 0;
+    while(seq < PER_PRODUCER)
+    {
+        switch(seq % 3)
+        {
+            case 0:
+                assert(!long_mpmc_push(&queue, ENCODE(id, seq)));
+                seq++;
+                break;
+            case 1:
+                if(long_mpmc_try_push(&queue, ENCODE(id, seq)) == 0) seq++;
+                else sched_yield();
+                break;
+            default:
+            {
+                size_t count = 0;
+                while((count < 8) && (seq + (long)count < PER_PRODUCER))
+                {
+                    buf[count] = ENCODE(id, seq + (long)count);
+                    count++;
+                }
+
+                size_t pushed = long_mpmc_push_many(&queue, buf, count);
+                if(pushed == 0) sched_yield();
+                seq += (long)pushed;
+                break;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/* Records a dequeued element. Elements of one producer must reach any single
+ * consumer in the order they were pushed. */
+static void
+consume(long val, long* last)
+{
+    assert((val >= 0) && (val < TOTAL));
+
+    long id = val / PER_PRODUCER;
+    assert(val > last[id]);
+    last[id] = val;
+
+    assert(atomic_fetch_add(&seen[val], 1) == 0);
+    atomic_fetch_add(&consumed, 1);
+}
+
+static void*
+consumer(void* arg)
+{
+    long last[PRODUCERS];
+    long buf[8];
+    long round = (long)(intptr_t)arg;
+
+    long id;
+    for(id = 0; id < PRODUCERS; id++)
+        last[id] = -1;
+
+    while(atomic_load(&consumed) < TOTAL)
+    {
+        if(round++ % 2 == 0)
+        {
+            long val;
+            if(long_mpmc_try_pop(&queue, &val) == 0) consume(val, last);
+            else sched_yield();
+            continue;
+        }
+
+        size_t count = long_mpmc_pop_many(&queue, buf, 8);
+        if(count == 0) sched_yield();
+
+        size_t i;
+        for(i = 0; i < count; i++)
+            consume(buf[i], last);
+    }
+
+    return NULL;
+}
+
+static void
+test_many_threads(void)
+{
+    assert(!long_mpmc_init(&queue, 64));
+    atomic_init(&consumed, 0);
+
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+
+    long i;
+    for(i = 0; i < CONSUMERS; i++)
+        assert(!pthread_create(&consumers[i], NULL, consumer,
+                               (void*)(intptr_t)i));
+    for(i = 0; i < PRODUCERS; i++)
+        assert(!pthread_create(&producers[i], NULL, producer,
+                               (void*)(intptr_t)i));
+
+    for(i = 0; i < PRODUCERS; i++)
+        assert(!pthread_join(producers[i], NULL));
+    for(i = 0; i < CONSUMERS; i++)
+        assert(!pthread_join(consumers[i], NULL));
+
+    /* Every element was dequeued exactly once. */
+    assert(atomic_load(&consumed) == TOTAL);
+    for(i = 0; i < TOTAL; i++)
+        assert(atomic_load(&seen[i]) == 1);
+    assert(long_mpmc_size(&queue) == 0);
+
+    assert(!long_mpmc_deinit(&queue));
+}
+
+static void*
+blocking_producer(void* arg)
+{
+    (void)arg;
+
+    long i;
+    for(i = 0; i < PER_PRODUCER; i++)
+        assert(!long_mpmc_push(&queue, i));
+
+    return NULL;
+}
+
+static void
+test_blocking(void)
+{
+    assert(!long_mpmc_init(&queue, 2));
+
+    pthread_t thread;
+    assert(!pthread_create(&thread, NULL, blocking_producer, NULL));
+
+    long i;
+    for(i = 0; i < PER_PRODUCER; i++)
+    {
+        long val;
+        assert(!long_mpmc_pop(&queue, &val));
+        assert(val == i);
+    }
+
+    assert(!pthread_join(thread, NULL));
+    assert(!long_mpmc_deinit(&queue));
+}
+
+int main()
+{
+    test_single_thread();
+    test_many_threads();
+    test_blocking();
+
+    printf("test_mpmc: ok\n");
+
+    return 0;
+}
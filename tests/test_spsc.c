@@ -0,0 +1,137 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "genc.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#ifndef GENC_HAS_ATOMICS
+#error "test_spsc requires C11 atomics"
+#endif
+
+GENC_SPSC_QUEUE_INLINE(long_spsc, long)
+
+#define COUNT 1000000L
+
+static void
+test_single_thread(void)
+{
+    struct long_spsc q;
+    assert(long_spsc_init(&q, 0) == GENC_ERR_INV_ARG);
+    assert(!long_spsc_init(&q, 5));
+    assert(q.cap == 8);
+
+    long out;
+    assert(long_spsc_pop(&q, &out) == GENC_ERR_NO_DATA);
+
+    /* Run the indices around the buffer several times. */
+    long next_in = 0;
+    long next_out = 0;
+    int lap;
+    for(lap = 0; lap < 20; lap++)
+    {
+        while(long_spsc_push(&q, next_in) == 0)
+            next_in++;
+        assert(long_spsc_size(&q) == 8);
+        assert(long_spsc_push(&q, -1) == GENC_ERR_FULL);
+
+        long buf[8];
+        size_t count = (size_t)(lap % 8) + 1;
+        assert(long_spsc_pop_many(&q, buf, count) == count);
+
+        size_t i;
+        for(i = 0; i < count; i++)
+            assert(buf[i] == next_out++);
+
+        long more[8] = { next_in, next_in + 1, next_in + 2, next_in + 3,
+                         next_in + 4, next_in + 5, next_in + 6, next_in + 7 };
+        assert(long_spsc_push_many(&q, more, 8) == count);
+        next_in += (long)count;
+
+        while(long_spsc_pop(&q, &out) == 0)
+            assert(out == next_out++);
+        assert(next_out == next_in);
+        assert(long_spsc_size(&q) == 0);
+    }
+
+    assert(!long_spsc_deinit(&q));
+}
+
+static void*
+producer(void* arg)
+{
+    struct long_spsc* q = arg;
+    long buf[16];
+
+    long next = 0;
+    while(next < COUNT)
+    {
+        if(next % 3 == 0)
+        {
+            if(long_spsc_push(q, next) == 0) next++;
+            else sched_yield();
+            continue;
+        }
+
+        size_t count = 0;
+        while((count < 16) && (next + (long)count < COUNT))
+        {
+            buf[count] = next + (long)count;
+            count++;
+        }
+
+        size_t pushed = long_spsc_push_many(q, buf, count);
+        if(pushed == 0) sched_yield();
+        next += (long)pushed;
+    }
+
+    return NULL;
+}
+
+static void
+test_two_threads(void)
+{
+    struct long_spsc q;
+    assert(!long_spsc_init(&q, 64));
+
+    pthread_t thread;
+    assert(!pthread_create(&thread, NULL, producer, &q));
+
+    /* Every element arrives exactly once and in order. */
+    long buf[16];
+    long next = 0;
+    while(next < COUNT)
+    {
+        if(next % 2 == 0)
+        {
+            long out;
+            if(long_spsc_pop(&q, &out) == 0) assert(out == next++);
+            else sched_yield();
+            continue;
+        }
+
+        size_t count = long_spsc_pop_many(&q, buf, 16);
+        if(count == 0) sched_yield();
+
+        size_t i;
+        for(i = 0; i < count; i++)
+            assert(buf[i] == next++);
+    }
+
+    assert(!pthread_join(thread, NULL));
+    assert(long_spsc_size(&q) == 0);
+
+    assert(!long_spsc_deinit(&q));
+}
+
+int main()
+{
+    test_single_thread();
+    test_two_threads();
+
+    printf("test_spsc: ok\n");
+
+    return 0;
+}
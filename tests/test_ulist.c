@@ -0,0 +1,170 @@
+#include "genc.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+GENC_ULIST_INLINE(int_ulist4, int, 4)
+GENC_ULIST_INLINE(int_ulist7, int, 7)
+
+#define REF_CAP 4096
+
+static uint64_t rng_state = 88172645463325252u;
+
+static uint64_t
+rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+
+    return rng_state;
+}
+
+/* Checks the links and element ranges of every node, and that the list holds
+ * exactly `REF[0..SIZE)`. Stores the number of nodes into `nodes`. */
+#define CHECK_LIST(NAME, N, LIST, REF, SIZE)                                   \
+do                                                                             \
+{                                                                              \
+    struct NAME##_node* prev = NULL;                                           \
+    struct NAME##_node* node = (LIST)->head;                                   \
+    size_t total = 0;                                                          \
+    nodes = 0;                                                                 \
+    while(node)                                                                \
+    {                                                                          \
+        assert(node->prev == prev);                                            \
+        assert(node->begin < node->end);                                       \
+        assert(node->end <= (N));                                              \
+        assert(!memcmp(node->data + node->begin, (REF) + total,                \
+                       (node->end - node->begin) * sizeof(int)));              \
+        total += node->end - node->begin;                                      \
+        nodes++;                                                               \
+        prev = node;                                                           \
+        node = node->next;                                                     \
+    }                                                                          \
+    assert((LIST)->tail == prev);                                              \
+    assert(total == (SIZE));                                                   \
+    assert((LIST)->size == (SIZE));                                            \
+                                                                               \
+    size_t i;                                                                  \
+    for(i = 0; i < (SIZE); i += 1 + (SIZE) / 16)                               \
+        assert(*NAME##_at((LIST), i) == (REF)[i]);                             \
+    assert(NAME##_at((LIST), (SIZE)) == NULL);                                 \
+} while(0)
+
+#define CHURN(NAME, N)                                                         \
+do                                                                             \
+{                                                                              \
+    struct NAME list = {0};                                                    \
+    static int ref[REF_CAP];                                                   \
+    size_t size = 0;                                                           \
+    size_t nodes;                                                              \
+    int next = 0;                                                              \
+                                                                               \
+    int op;                                                                    \
+    for(op = 0; op < 100000; op++)                                             \
+    {                                                                          \
+        bool grow = (op / 4000) % 2 == 0;                                      \
+        int kind = (int)(rng() % 6);                                           \
+                                                                               \
+        if((grow && (kind < 3) && (size < REF_CAP)) || (size == 0))            \
+        {                                                                      \
+            size_t pos = (size_t)(rng() % (size + 1));                         \
+            if(kind == 1) pos = 0;                                             \
+            if(kind == 2) pos = size;                                          \
+            memmove(ref + pos + 1, ref + pos, (size - pos) * sizeof(int));     \
+            ref[pos] = next;                                                   \
+            size++;                                                            \
+                                                                               \
+            if(kind == 1) assert(!NAME##_pushf(&list, next));                  \
+            else if(kind == 2) assert(!NAME##_pushb(&list, next));             \
+            else assert(!NAME##_ins(&list, next, pos));                        \
+            next++;                                                            \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            size_t pos = (size_t)(rng() % size);                               \
+            if(kind == 1) pos = 0;                                             \
+            if(kind == 2) pos = size - 1;                                      \
+            memmove(ref + pos, ref + pos + 1, (size - pos - 1) * sizeof(int)); \
+            size--;                                                            \
+                                                                               \
+            if(kind == 1) assert(!NAME##_popf(&list));                         \
+            else if(kind == 2) assert(!NAME##_popb(&list));                    \
+            else assert(!NAME##_rm_at(&list, pos));                            \
+        }                                                                      \
+                                                                               \
+        if(op % 53 == 0) CHECK_LIST(NAME, N, &list, ref, size);                \
+    }                                                                          \
+    CHECK_LIST(NAME, N, &list, ref, size);                                     \
+                                                                               \
+    assert(NAME##_ins(&list, 0, size + 1) == GENC_ERR_OUT_OF_BOUNDS);          \
+    assert(NAME##_rm_at(&list, size) == GENC_ERR_OUT_OF_BOUNDS);               \
+                                                                               \
+    /* Chunk iteration visits every element once, in order. */                 \
+    struct NAME##_node* node = NULL;                                           \
+    size_t count;                                                              \
+    size_t seen = 0;                                                           \
+    int* data;                                                                 \
+    while((data = NAME##_next_chunk(&list, &node, &count)))                    \
+    {                                                                          \
+        assert(!memcmp(data, ref + seen, count * sizeof(int)));                \
+        seen += count;                                                         \
+    }                                                                          \
+    assert(seen == size);                                                      \
+                                                                               \
+    assert(!NAME##_deinit(&list));                                             \
+} while(0)
+
+static void
+test_split_merge(void)
+{
+    struct int_ulist4 list = {0};
+    int ref[8];
+    size_t nodes;
+
+    int i;
+    for(i = 0; i < 4; i++)
+    {
+        assert(!int_ulist4_pushb(&list, i * 10));
+        ref[i] = i * 10;
+    }
+    CHECK_LIST(int_ulist4, 4, &list, ref, 4);
+    assert(nodes == 1);
+
+    /* Inserting into the full node splits it in two. */
+    assert(!int_ulist4_ins(&list, 15, 2));
+    int split[5] = { 0, 10, 15, 20, 30 };
+    CHECK_LIST(int_ulist4, 4, &list, split, 5);
+    assert(nodes == 2);
+
+    /* Once the two halves fit in one node again, removal merges them. */
+    assert(!int_ulist4_rm_at(&list, 2));
+    int merged[4] = { 0, 10, 20, 30 };
+    CHECK_LIST(int_ulist4, 4, &list, merged, 4);
+    assert(nodes == 1);
+
+    /* Removing the last element of a node unlinks it. */
+    while(list.size > 0)
+        assert(!int_ulist4_popf(&list));
+    assert(!list.head && !list.tail);
+    assert(int_ulist4_popb(&list) == GENC_ERR_NO_DATA);
+
+    assert(!int_ulist4_deinit(&list));
+}
+
+static void
+test_churn(void)
+{
+    CHURN(int_ulist4, 4);
+    CHURN(int_ulist7, 7);
+}
+
+int main()
+{
+    test_split_merge();
+    test_churn();
+
+    printf("test_ulist: ok\n");
+
+    return 0;
+}